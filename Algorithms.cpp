@@ -1,19 +1,698 @@
 // Email: origoldbsc@gmail.com
 
 #include "Algorithms.hpp"
+#include "DisjointSet.hpp"
+#include "Parallel.hpp"
 #include <queue>
 #include <sstream>
 #include <algorithm>
 #include <climits>
+#include <cstdlib>
+#include <stdexcept>
+#include <cstdint>
 #include <unordered_set>
 #include <iostream>
-#include <stack>  
+#include <atomic>
+#include <memory>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 
 using namespace std;
 
 namespace ariel {
-    
+
+    /*********************************************/
+    ///               BFS ENGINE                ///
+    /*********************************************/
+
+    namespace {
+
+        const size_t BFS_GRAIN_WORDS = 64;      // The minimal number of bitmap words (64 vertices each) handed to a thread
+        const size_t BFS_ALPHA = 14;            // Go bottom-up when the frontier has more than 1/ALPHA of the unexplored edges
+        const size_t BFS_BETA = 24;             // Go back top-down when the frontier has less than 1/BETA of the vertices
+
+        const size_t DENSE_DIJKSTRA_RATIO = 16;     // Graphs with at least 1/RATIO of all possible edges use the array Dijkstra
+        const int DIAL_MAX_WEIGHT = 255;            // Sparse graphs with weights up to this value use Dial's buckets
+        const int RADIX_HEAP_MAX_WEIGHT = 1 << 16;  // Sparse graphs with weights up to this value use a radix heap
+        const size_t PARALLEL_SSSP_MIN_VERTICES = 1 << 16;  // Graphs with at least this many vertices use the parallel searches
+        const size_t SSSP_GRAIN_VERTICES = 256;     // The minimal number of frontier vertices handed to a thread
+
+
+        /**
+         * @brief This auxiliary function checks if the bit of a vertex is set in a bitmap.
+         */
+        inline bool testBit(const vector<uint64_t>& bitmap, size_t vertex)
+        {
+            return ((bitmap[vertex >> 6] >> (vertex & 63)) & 1) != 0;
+        }
+
+
+        /**
+         * @brief This auxiliary function lowers a distance shared between threads to a candidate, if the candidate is smaller.
+         * @return true if this call lowered the distance.
+         */
+        inline bool relaxDistance(atomic<long long>& distance, long long candidate)
+        {
+            long long current = distance.load(memory_order_relaxed);
+            while (candidate < current)
+            {
+                if (distance.compare_exchange_weak(current, candidate, memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+
+        /**
+         * @brief This auxiliary function checks if the parent pointers of a Bellman-Ford search close a negative cycle.
+         *
+         * The parents are written by several threads, so a parent may be out of date; every cycle of parents is therefore
+         * summed over the edges of the graph, and only a negative sum counts.
+         *
+         * @param edges The edges of the graph.
+         * @param parent The parent of every vertex (SIZE_MAX for none).
+         * @return true if a negative cycle was found.
+         */
+        bool hasNegativeParentCycle(const AdjacencyIndex& edges, const vector<atomic<size_t>>& parent)
+        {
+            size_t numVertices = parent.size();
+            vector<size_t> walk(numVertices, SIZE_MAX);          // The first vertex of the walk that reached each vertex
+
+            for (size_t first = 0; first < numVertices; first++)
+            {
+                size_t current = first;
+                while (current != SIZE_MAX && walk[current] == SIZE_MAX)
+                {
+                    walk[current] = first;
+                    current = parent[current].load(memory_order_relaxed);
+                }
+
+                // Only a vertex reached twice by the same walk closes a new cycle
+                if (current == SIZE_MAX || walk[current] != first)
+                {
+                    continue;
+                }
+                long long weight = 0;
+                size_t vertex_v = current;
+                do
+                {
+                    size_t vertex_u = parent[vertex_v].load(memory_order_relaxed);
+                    weight += edges.findWeight(vertex_u, vertex_v);
+                    vertex_v = vertex_u;
+                } while (vertex_v != current);
+                if (weight < 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+
+        /**
+         * @brief This auxiliary function formats a sequence of vertices as a string, e.g. "0->3->5".
+         */
+        string joinVertices(const vector<size_t>& vertices)
+        {
+            string joined;
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                if (i > 0)
+                {
+                    joined += "->";
+                }
+                joined += to_string(vertices[i]);
+            }
+            return joined;
+        }
+
+
+        /**
+         * @brief This auxiliary function runs a level-synchronous, direction-optimizing BFS over CSR indexes.
+         *
+         * Each level is expanded either top-down (the frontier pushes along its forward edges) or bottom-up (every
+         * unvisited vertex looks for a parent in the frontier along its backward edges), following Beamer's heuristic.
+         * Both directions work on frontier bitmaps and are split between threads by ranges of bitmap words.
+         * The parent of a vertex is always its smallest-index neighbour in the previous level, so the result does not
+         * depend on the direction or the number of threads.
+         *
+         * @param forward The edges to traverse.
+         * @param backward The same edges reversed.
+         * @param source The vertex to start from.
+         * @param target The search stops after the level that reaches this vertex (pass a value >= the number of vertices to never stop).
+         * @param visited Set to a bitmap of the reached vertices.
+         * @param parent The parent of every reached vertex except the source is written here.
+         */
+        void directionOptimizingBfs(const AdjacencyIndex& forward, const AdjacencyIndex& backward, size_t source, size_t target,
+                                    vector<uint64_t>& visited, vector<size_t>& parent)
+        {
+            size_t numVertices = forward.numVertices;
+            size_t numWords = (numVertices + 63) / 64;
+            visited.assign(numWords, 0);
+            vector<uint64_t> frontier(numWords, 0);
+            unique_ptr<atomic<uint64_t>[]> next(new atomic<uint64_t>[numWords]);
+            unique_ptr<atomic<size_t>[]> levelParent(new atomic<size_t>[numVertices]);
+            for (size_t i = 0; i < numWords; i++)
+            {
+                next[i].store(0, memory_order_relaxed);
+            }
+            for (size_t v = 0; v < numVertices; v++)
+            {
+                levelParent[v].store(SIZE_MAX, memory_order_relaxed);
+            }
+
+            visited[source >> 6] |= uint64_t(1) << (source & 63);
+            frontier[source >> 6] |= uint64_t(1) << (source & 63);
+            size_t frontierVertices = 1;                                // The number of vertices in the frontier
+            size_t frontierEdges = forward.degree(source);              // The number of forward edges leaving the frontier
+            size_t unexploredEdges = forward.numEntries() - frontierEdges;     // The number of forward edges leaving unvisited vertices
+            bool bottomUp = false;
+
+            while (frontierVertices > 0 && !(target < numVertices && testBit(visited, target)))
+            {
+                // Choose the direction of this level
+                if (!bottomUp && frontierEdges > unexploredEdges / BFS_ALPHA)
+                {
+                    bottomUp = true;
+                }
+                else if (bottomUp && frontierVertices < numVertices / BFS_BETA)
+                {
+                    bottomUp = false;
+                }
+
+                if (bottomUp)
+                {
+                    // Every unvisited vertex takes the first (smallest) frontier vertex among its backward neighbours
+                    Parallel::forRange(numWords, BFS_GRAIN_WORDS, [&](size_t beginWord, size_t endWord)
+                    {
+                        for (size_t word = beginWord; word < endWord; word++)
+                        {
+                            uint64_t found = 0;
+                            size_t last = min(numVertices, (word + 1) * 64);
+                            for (size_t vertex_v = word * 64; vertex_v < last; vertex_v++)
+                            {
+                                if (testBit(visited, vertex_v))
+                                {
+                                    continue;
+                                }
+                                for (size_t e = backward.offsets[vertex_v]; e < backward.offsets[vertex_v + 1]; e++)
+                                {
+                                    size_t vertex_u = backward.targets[e];
+                                    if (testBit(frontier, vertex_u))
+                                    {
+                                        levelParent[vertex_v].store(vertex_u, memory_order_relaxed);
+                                        found |= uint64_t(1) << (vertex_v & 63);
+                                        break;
+                                    }
+                                }
+                            }
+                            next[word].store(found, memory_order_relaxed);
+                        }
+                    });
+                }
+                else
+                {
+                    // Every frontier vertex pushes along its forward edges; the smallest parent wins
+                    Parallel::forRange(numWords, BFS_GRAIN_WORDS, [&](size_t beginWord, size_t endWord)
+                    {
+                        for (size_t word = beginWord; word < endWord; word++)
+                        {
+                            uint64_t bits = frontier[word];
+                            while (bits != 0)
+                            {
+                                size_t vertex_u = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                                bits &= bits - 1;
+                                for (size_t e = forward.offsets[vertex_u]; e < forward.offsets[vertex_u + 1]; e++)
+                                {
+                                    size_t vertex_v = forward.targets[e];
+                                    if (testBit(visited, vertex_v))
+                                    {
+                                        continue;
+                                    }
+                                    size_t current = levelParent[vertex_v].load(memory_order_relaxed);
+                                    while (vertex_u < current && !levelParent[vertex_v].compare_exchange_weak(current, vertex_u, memory_order_relaxed))
+                                    {
+                                    }
+                                    next[vertex_v >> 6].fetch_or(uint64_t(1) << (vertex_v & 63), memory_order_relaxed);
+                                }
+                            }
+                        }
+                    });
+                }
+
+                // The next level becomes the frontier
+                atomic<size_t> levelVertices(0);
+                atomic<size_t> levelEdges(0);
+                Parallel::forRange(numWords, BFS_GRAIN_WORDS, [&](size_t beginWord, size_t endWord)
+                {
+                    size_t localVertices = 0;
+                    size_t localEdges = 0;
+                    for (size_t word = beginWord; word < endWord; word++)
+                    {
+                        uint64_t bits = next[word].exchange(0, memory_order_relaxed);
+                        frontier[word] = bits;
+                        visited[word] |= bits;
+                        localVertices += static_cast<size_t>(__builtin_popcountll(bits));
+                        while (bits != 0)
+                        {
+                            localEdges += forward.degree(word * 64 + static_cast<size_t>(__builtin_ctzll(bits)));
+                            bits &= bits - 1;
+                        }
+                    }
+                    levelVertices += localVertices;
+                    levelEdges += localEdges;
+                });
+                frontierVertices = levelVertices.load();
+                frontierEdges = levelEdges.load();
+                unexploredEdges -= frontierEdges;
+            }
+
+            // Hand the parents of the reached vertices to the caller
+            for (size_t v = 0; v < numVertices; v++)
+            {
+                size_t vertexParent = levelParent[v].load(memory_order_relaxed);
+                if (vertexParent != SIZE_MAX)
+                {
+                    parent[v] = vertexParent;
+                }
+            }
+        }
+    }
+
+
+    /*********************************************/
+    ///            ALL-PAIRS ENGINE             ///
+    /*********************************************/
+
+    namespace {
+
+        const size_t FLOYD_BLOCK_SIZE = 64;             // The side of the square blocks of the blocked Floyd-Warshall
+        const int FLOYD_INT_INFINITY = INT_MAX / 2;     // Sums of two distances in [-infinity, infinity] do not overflow an int
+        const size_t SEIDEL_TABLE_BITS = 8;             // The rows of the right matrix combined into one lookup table
+        const size_t SEIDEL_GRAIN_ROWS = 256;           // The minimal number of rows of a boolean product handed to a thread
+        const size_t SEIDEL_DENSITY_RATIO = 4;          // Undirected graphs with at least 1/RATIO of all possible edges use Seidel
+
+
+        /**
+         * @brief This auxiliary function relaxes the row i of a block through a vertex k: C[i][j] = min(C[i][j], A[i][k] + B[k][j]).
+         *
+         * Sums are clamped at -infinity, so they cannot overflow even if the graph has a negative cycle.
+         *
+         * @param rowC The distances from i in the block being relaxed.
+         * @param rowNext The next hops from i in the block being relaxed.
+         * @param rowB The distances from k.
+         * @param distance_ik The distance from i to k (not infinity).
+         * @param next_ik The next hop from i towards k.
+         * @param infinity The distance of unreachable vertices.
+         */
+        template <typename T>
+        inline void relaxFloydRow(T* rowC, int* rowNext, const T* rowB, T distance_ik, int next_ik, T infinity)
+        {
+            for (size_t j = 0; j < FLOYD_BLOCK_SIZE; j++)
+            {
+                if (rowB[j] == infinity)
+                {
+                    continue;
+                }
+                T candidate = max(distance_ik + rowB[j], -infinity);
+                if (candidate < rowC[j])
+                {
+                    rowC[j] = candidate;
+                    rowNext[j] = next_ik;
+                }
+            }
+        }
+
+
+#ifdef __SSE2__
+        /**
+         * @brief This auxiliary function relaxes the row i of a block through a vertex k, four distances at a time.
+         */
+        inline void relaxFloydRow(int* rowC, int* rowNext, const int* rowB, int distance_ik, int next_ik, int infinity)
+        {
+            __m128i base = _mm_set1_epi32(distance_ik);
+            __m128i hop = _mm_set1_epi32(next_ik);
+            __m128i unreachable = _mm_set1_epi32(infinity);
+            __m128i floor = _mm_set1_epi32(-infinity);
+            for (size_t j = 0; j < FLOYD_BLOCK_SIZE; j += 4)
+            {
+                __m128i distance_kj = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowB + j));
+                __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowC + j));
+                __m128i candidate = _mm_add_epi32(base, distance_kj);
+                __m128i low = _mm_cmpgt_epi32(floor, candidate);
+                candidate = _mm_or_si128(_mm_and_si128(low, floor), _mm_andnot_si128(low, candidate));
+
+                // k must reach j, and the path through k must be shorter
+                __m128i improves = _mm_andnot_si128(_mm_cmpeq_epi32(distance_kj, unreachable), _mm_cmpgt_epi32(current, candidate));
+                if (_mm_movemask_epi8(improves) == 0)
+                {
+                    continue;
+                }
+                __m128i hops = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowNext + j));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(rowC + j), _mm_or_si128(_mm_and_si128(improves, candidate), _mm_andnot_si128(improves, current)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(rowNext + j), _mm_or_si128(_mm_and_si128(improves, hop), _mm_andnot_si128(improves, hops)));
+            }
+        }
+#endif
+
+
+        /**
+         * @brief This auxiliary function relaxes a block C of the distance matrix through the vertices k of a diagonal block.
+         *
+         * For every k in order, C[i][j] = min(C[i][j], A[i][k] + B[k][j]), where A holds the distances from the rows of C to k
+         * and B the distances from k to the columns of C. The blocks may be the same (the diagonal block, its row and its
+         * column), as in the plain Floyd-Warshall.
+         *
+         * @param distanceC The top-left corner of C (and nextC of its next hops).
+         * @param distanceA The top-left corner of A (and nextA of its next hops).
+         * @param distanceB The top-left corner of B.
+         * @param stride The length of a row of the matrix.
+         * @param infinity The distance of unreachable vertices.
+         */
+        template <typename T>
+        void relaxFloydBlock(T* distanceC, int* nextC, const T* distanceA, const int* nextA, const T* distanceB, size_t stride, T infinity)
+        {
+            for (size_t k = 0; k < FLOYD_BLOCK_SIZE; k++)
+            {
+                for (size_t i = 0; i < FLOYD_BLOCK_SIZE; i++)
+                {
+                    T distance_ik = distanceA[i * stride + k];
+                    if (distance_ik != infinity)
+                    {
+                        relaxFloydRow(distanceC + i * stride, nextC + i * stride, distanceB + k * stride, distance_ik, nextA[i * stride + k], infinity);
+                    }
+                }
+            }
+        }
+
+
+        /**
+         * @brief This auxiliary function runs a cache-blocked, multithreaded Floyd-Warshall over a padded distance matrix.
+         *
+         * Round kb relaxes the diagonal block kb through itself, then the other blocks of its row and column through it (in
+         * parallel), and then every remaining block through its row and column (in parallel, a row of blocks per task). Every
+         * block fits in the L1 or L2 cache, and the result does not depend on the number of threads.
+         *
+         * @param distance The matrix of distances (row-major, with rows of stride entries), relaxed in place.
+         * @param next The matrix of next hops, updated together with distance.
+         * @param stride The number of rows and columns (a multiple of FLOYD_BLOCK_SIZE).
+         * @param infinity The distance of unreachable vertices.
+         * @return true if a negative cycle was found (a negative distance from a vertex to itself).
+         */
+        template <typename T>
+        bool blockedFloydWarshall(vector<T>& distance, vector<int>& next, size_t stride, T infinity)
+        {
+            size_t numBlocks = stride / FLOYD_BLOCK_SIZE;
+            T* data = distance.data();
+            int* hops = next.data();
+
+            for (size_t kb = 0; kb < numBlocks; kb++)
+            {
+                size_t diagonal = kb * FLOYD_BLOCK_SIZE * (stride + 1);
+                relaxFloydBlock(data + diagonal, hops + diagonal, data + diagonal, hops + diagonal, data + diagonal, stride, infinity);
+
+                // The row and the column of the diagonal block go through it
+                Parallel::forRange(numBlocks, 1, [&](size_t begin, size_t end)
+                {
+                    for (size_t b = begin; b < end; b++)
+                    {
+                        if (b == kb)
+                        {
+                            continue;
+                        }
+                        size_t row = kb * FLOYD_BLOCK_SIZE * stride + b * FLOYD_BLOCK_SIZE;
+                        size_t column = b * FLOYD_BLOCK_SIZE * stride + kb * FLOYD_BLOCK_SIZE;
+                        relaxFloydBlock(data + row, hops + row, data + diagonal, hops + diagonal, data + row, stride, infinity);
+                        relaxFloydBlock(data + column, hops + column, data + column, hops + column, data + diagonal, stride, infinity);
+                    }
+                });
+
+                // Every other block goes through the blocks of its row and column in the diagonal's row and column
+                Parallel::forRange(numBlocks, 1, [&](size_t begin, size_t end)
+                {
+                    for (size_t ib = begin; ib < end; ib++)
+                    {
+                        if (ib == kb)
+                        {
+                            continue;
+                        }
+                        size_t column = ib * FLOYD_BLOCK_SIZE * stride + kb * FLOYD_BLOCK_SIZE;
+                        for (size_t jb = 0; jb < numBlocks; jb++)
+                        {
+                            if (jb == kb)
+                            {
+                                continue;
+                            }
+                            size_t block = ib * FLOYD_BLOCK_SIZE * stride + jb * FLOYD_BLOCK_SIZE;
+                            size_t row = kb * FLOYD_BLOCK_SIZE * stride + jb * FLOYD_BLOCK_SIZE;
+                            relaxFloydBlock(data + block, hops + block, data + column, hops + column, data + row, stride, infinity);
+                        }
+                    }
+                });
+
+                // A vertex with a negative distance to itself is on a negative cycle
+                for (size_t i = 0; i < stride; i++)
+                {
+                    if (data[i * (stride + 1)] < 0)
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+
+        /**
+         * @brief This auxiliary function computes the shortest paths between all pairs of vertices with distances of type T.
+         *
+         * @param edges The edges of the graph.
+         * @param numVertices The number of vertices.
+         * @param infinity The distance of unreachable vertices (larger than any path, and its double must fit in T).
+         * @param result Filled with the distances and next hops, or marked as having a negative cycle.
+         */
+        template <typename T>
+        void floydWarshall(const AdjacencyIndex& edges, size_t numVertices, T infinity, AllPairsShortestPaths& result)
+        {
+            // Pad the matrix to whole blocks; the padding vertices have no edges
+            size_t stride = (numVertices + FLOYD_BLOCK_SIZE - 1) / FLOYD_BLOCK_SIZE * FLOYD_BLOCK_SIZE;
+            vector<T> distance(stride * stride, infinity);
+            vector<int> next(stride * stride, -1);
+            for (size_t vertex_u = 0; vertex_u < stride; vertex_u++)
+            {
+                distance[vertex_u * (stride + 1)] = 0;
+                next[vertex_u * (stride + 1)] = static_cast<int>(vertex_u);
+            }
+            for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+            {
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                {
+                    size_t vertex_v = edges.targets[e];
+                    T weight = static_cast<T>(edges.weights[e]);
+                    if (weight < distance[vertex_u * stride + vertex_v])
+                    {
+                        distance[vertex_u * stride + vertex_v] = weight;
+                        next[vertex_u * stride + vertex_v] = static_cast<int>(vertex_v);
+                    }
+                }
+            }
+
+            result.hasNegativeCycle = blockedFloydWarshall(distance, next, stride, infinity);
+            if (result.hasNegativeCycle)
+            {
+                return;
+            }
+
+            result.distance.assign(numVertices, vector<long long>(numVertices));
+            result.next.assign(numVertices, vector<size_t>(numVertices));
+            for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+            {
+                for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++)
+                {
+                    T value = distance[vertex_u * stride + vertex_v];
+                    int hop = next[vertex_u * stride + vertex_v];
+                    result.distance[vertex_u][vertex_v] = value == infinity ? LLONG_MAX : static_cast<long long>(value);
+                    result.next[vertex_u][vertex_v] = hop < 0 ? SIZE_MAX : static_cast<size_t>(hop);
+                }
+            }
+        }
+
+
+        /**
+         * @brief This auxiliary function multiplies boolean matrices stored as bitmaps (one row of words per vertex) by the same
+         * right matrix: products[m][i] = the OR of the rows k of right for every bit k set in lefts[m][i].
+         *
+         * The rows of the right matrix are combined SEIDEL_TABLE_BITS at a time into a table of all their ORs (the method of
+         * Four Russians), so every byte of a left row costs one table lookup. Blocks of rows run in parallel.
+         *
+         * @param lefts The left matrices.
+         * @param right The right matrix.
+         * @param products The products (cleared by the caller), one per left matrix.
+         * @param numVertices The number of rows and columns.
+         * @param words The number of words per row.
+         */
+        void multiplyBitMatrices(const vector<const uint64_t*>& lefts, const uint64_t* right, const vector<uint64_t*>& products,
+            size_t numVertices, size_t words)
+        {
+            Parallel::forRange(numVertices, SEIDEL_GRAIN_ROWS, [&](size_t begin, size_t end)
+            {
+                vector<uint64_t> table((size_t(1) << SEIDEL_TABLE_BITS) * words, 0);
+                for (size_t first = 0; first < numVertices; first += SEIDEL_TABLE_BITS)
+                {
+                    // table[s] is the OR of the rows first + b of the right matrix for every bit b of s
+                    size_t count = min(SEIDEL_TABLE_BITS, numVertices - first);
+                    for (size_t s = 1; s < (size_t(1) << count); s++)
+                    {
+                        const uint64_t* base = &table[(s & (s - 1)) * words];
+                        const uint64_t* row = right + (first + static_cast<size_t>(__builtin_ctzll(s))) * words;
+                        uint64_t* entry = &table[s * words];
+                        for (size_t w = 0; w < words; w++)
+                        {
+                            entry[w] = base[w] | row[w];
+                        }
+                    }
+
+                    // A group never crosses a word, and the bits past the last vertex are clear
+                    size_t mask = (size_t(1) << SEIDEL_TABLE_BITS) - 1;
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        for (size_t m = 0; m < lefts.size(); m++)
+                        {
+                            size_t s = static_cast<size_t>(lefts[m][i * words + (first >> 6)] >> (first & 63)) & mask;
+                            if (s == 0)
+                            {
+                                continue;
+                            }
+                            const uint64_t* entry = &table[s * words];
+                            uint64_t* product = products[m] + i * words;
+                            for (size_t w = 0; w < words; w++)
+                            {
+                                product[w] |= entry[w];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+
+        /**
+         * @brief This auxiliary function computes the hop distances between all pairs of vertices of an undirected graph with
+         * Seidel's algorithm.
+         *
+         * The graph is squared (u and v become adjacent if they are at most 2 hops apart) until every connected component is a
+         * clique. Walking back down, the distance D in a graph follows from the distance T in its square: D = 2T, or 2T - 1 if
+         * some neighbour k of v has T(u, k) = T(u, v) - 1. The neighbours of v are at most 1 apart in the square, so it is
+         * enough to test T(u, k) mod 3, which takes three boolean products (one table pass) per level.
+         *
+         * @param edges The edges of the graph (every edge u->v has an edge v->u).
+         * @param numVertices The number of vertices.
+         * @return For each vertex, the hop distance to every vertex (SIZE_MAX for unreachable vertices).
+         */
+        vector<vector<size_t>> seidelHopDistances(const AdjacencyIndex& edges, size_t numVertices)
+        {
+            size_t words = (numVertices + 63) / 64;
+            vector<vector<uint64_t>> levels(1, vector<uint64_t>(numVertices * words, 0));     // The graph and its squares
+            for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+            {
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                {
+                    size_t vertex_v = edges.targets[e];
+                    if (vertex_v != vertex_u)
+                    {
+                        levels[0][vertex_u * words + (vertex_v >> 6)] |= uint64_t(1) << (vertex_v & 63);
+                    }
+                }
+            }
+
+            // Square the graph until it stops growing
+            while (true)
+            {
+                vector<uint64_t> square(numVertices * words, 0);
+                multiplyBitMatrices(vector<const uint64_t*>(1, levels.back().data()), levels.back().data(),
+                    vector<uint64_t*>(1, square.data()), numVertices, words);
+
+                bool grown = false;
+                const vector<uint64_t>& adjacency = levels.back();
+                for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+                {
+                    square[vertex_u * words + (vertex_u >> 6)] &= ~(uint64_t(1) << (vertex_u & 63));
+                    for (size_t w = vertex_u * words; w < (vertex_u + 1) * words; w++)
+                    {
+                        square[w] |= adjacency[w];
+                        grown = grown || square[w] != adjacency[w];
+                    }
+                }
+                if (!grown)
+                {
+                    break;
+                }
+                levels.push_back(move(square));
+            }
+
+            // In the last square every component is a clique
+            vector<vector<size_t>> distance(numVertices, vector<size_t>(numVertices, SIZE_MAX));
+            for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+            {
+                for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++)
+                {
+                    if (testBit(levels.back(), vertex_u * words * 64 + vertex_v))
+                    {
+                        distance[vertex_u][vertex_v] = 1;
+                    }
+                }
+                distance[vertex_u][vertex_u] = 0;
+            }
+
+            vector<uint64_t> residue(3 * numVertices * words);      // The vertices at each distance mod 3 from every vertex
+            vector<uint64_t> reached(3 * numVertices * words);      // The vertices with a neighbour in each of those sets
+            for (size_t level = levels.size() - 1; level-- > 0; )
+            {
+                fill(residue.begin(), residue.end(), 0);
+                fill(reached.begin(), reached.end(), 0);
+                for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+                {
+                    for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++)
+                    {
+                        size_t hops = distance[vertex_u][vertex_v];
+                        if (hops != SIZE_MAX)
+                        {
+                            residue[(hops % 3 * numVertices + vertex_u) * words + (vertex_v >> 6)] |= uint64_t(1) << (vertex_v & 63);
+                        }
+                    }
+                }
+
+                vector<const uint64_t*> lefts;
+                vector<uint64_t*> products;
+                for (size_t r = 0; r < 3; r++)
+                {
+                    lefts.push_back(&residue[r * numVertices * words]);
+                    products.push_back(&reached[r * numVertices * words]);
+                }
+                multiplyBitMatrices(lefts, levels[level].data(), products, numVertices, words);
+
+                for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+                {
+                    for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++)
+                    {
+                        size_t& hops = distance[vertex_u][vertex_v];
+                        if (hops != SIZE_MAX)
+                        {
+                            size_t previous = (hops + 2) % 3 * numVertices + vertex_u;
+                            hops = 2 * hops - (testBit(reached, previous * words * 64 + vertex_v) ? 1 : 0);
+                        }
+                    }
+                }
+            }
+
+            return distance;
+        }
+    }
+
     
     /**
      * @brief This method checks if all vertices in a given graph reachable from the vertex with index 0 by using BFS algorithm.
@@ -21,583 +700,2384 @@ namespace ariel {
      * @param graph The graph to check.
      * @return true if all vertices are reachable; otherwise, false.
      */
-    bool Algorithms::isConnected(Graph& graph) 
+    bool Algorithms::isConnected(const Graph& graph) 
     {
         size_t numVertices = graph.getNumVertices();
 
         // Check if the graph is trivially connected
-        if (numVertices == 1) 
+        if (numVertices <= 1) 
+        {
+            return true;
+        }
+
+        vector<bool> visited(numVertices, false);          // Initialize a vector with numVertices elements and sets each of them to false
+
+        vector<size_t> parent(numVertices, SIZE_MAX);      // Create a dummy parent vector (added to make bfs function to be used for finding shortest path as well)
+        bfs(graph, 0, visited, parent, SIZE_MAX, false);   // Perform BFS starting from vertex 0 (SIZE_MAX and "false" are dummy variables, from the reason mentioned above)
+
+        // If any vertex was not visited, the graph is not connected
+        for (size_t i = 0; i < numVertices; i++) 
+        {
+            if (!visited[i]) 
+            {
+                return false; 
+            }
+        }
+
+        return true;
+    }
+
+
+    /**
+     * This function checks if a given graph is strongly connected, i.e. if it has a single strongly connected component.
+     *
+     * @param graph The graph to check.
+     * @return true if the graph is strongly connected; otherwise, false.
+     */
+    bool Algorithms::isStronglyConnected(const Graph& graph) 
+    {
+        // The graph is trivially strongly connected
+        if (graph.getNumVertices() <= 1) 
         {
             return true;
         }
 
-        vector<bool> visited(numVertices, false);          // Initialize a vector with numVertices elements and sets each of them to false
-
-        vector<size_t> parent(numVertices, INT_MAX);       // Create a dummy parent vector (added to make bfs function to be used for finding shortest path as well)
-        bfs(graph, 0, visited, parent, INT_MAX, false);    // Perform BFS starting from vertex 0 (INT_MAX and "false" are dummy variables, from the reason mentioned above)
-
-        // If any vertex was not visited, the graph is not connected
-        for (size_t i = 0; i < numVertices; i++) 
+        // Every vertex must be in component 0
+        vector<size_t> component = stronglyConnectedComponents(graph);
+        return *max_element(component.begin(), component.end()) == 0;
+    }
+
+
+    /**
+     * @brief This method finds the strongly connected components of a graph using an iterative Tarjan's algorithm.
+     *
+     * Time complexity: O(|V|+|E|). Components are numbered in reverse topological order: every edge between two
+     * components goes from a component with a larger id to a component with a smaller id.
+     *
+     * @param graph The graph.
+     * @return The id of the component of each vertex (0 .. number of components - 1).
+     */
+    vector<size_t> Algorithms::stronglyConnectedComponents(const Graph& graph)
+    {
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        size_t numVertices = graph.getNumVertices();
+        vector<size_t> component(numVertices, SIZE_MAX);    // The component of each vertex (SIZE_MAX until it is assigned)
+        vector<size_t> order(numVertices, SIZE_MAX);        // The DFS discovery order of each vertex (SIZE_MAX = not discovered)
+        vector<size_t> lowLink(numVertices, 0);             // The smallest discovery order reachable from the DFS subtree of each vertex
+        vector<size_t> sccStack;                            // Discovered vertices whose component is not known yet
+        vector<pair<size_t, size_t>> callStack;             // The DFS path: (vertex, position of the next edge to explore)
+        size_t nextOrder = 0;
+        size_t numComponents = 0;
+
+        for (size_t root = 0; root < numVertices; root++)
+        {
+            if (order[root] != SIZE_MAX)
+            {
+                continue;
+            }
+
+            order[root] = lowLink[root] = nextOrder++;
+            sccStack.push_back(root);
+            callStack.push_back(make_pair(root, edges.offsets[root]));
+
+            while (!callStack.empty())
+            {
+                size_t vertex_u = callStack.back().first;
+                size_t& nextEdge = callStack.back().second;
+
+                // Explore the next edge of u (the iterative form of the recursive call)
+                if (nextEdge < edges.offsets[vertex_u + 1])
+                {
+                    size_t vertex_v = edges.targets[nextEdge++];
+                    if (order[vertex_v] == SIZE_MAX)
+                    {
+                        order[vertex_v] = lowLink[vertex_v] = nextOrder++;
+                        sccStack.push_back(vertex_v);
+                        callStack.push_back(make_pair(vertex_v, edges.offsets[vertex_v]));
+                    }
+                    else if (component[vertex_v] == SIZE_MAX)       // v is still on the SCC stack
+                    {
+                        lowLink[vertex_u] = min(lowLink[vertex_u], order[vertex_v]);
+                    }
+                    continue;
+                }
+
+                // All edges of u are explored: if u is the root of a component, pop the component
+                callStack.pop_back();
+                if (lowLink[vertex_u] == order[vertex_u])
+                {
+                    size_t vertex_w = 0;
+                    do
+                    {
+                        vertex_w = sccStack.back();
+                        sccStack.pop_back();
+                        component[vertex_w] = numComponents;
+                    } while (vertex_w != vertex_u);
+                    numComponents++;
+                }
+                if (!callStack.empty())
+                {
+                    size_t parent = callStack.back().first;
+                    lowLink[parent] = min(lowLink[parent], lowLink[vertex_u]);
+                }
+            }
+        }
+
+        return component;
+    }
+
+
+    /**
+     * @brief This method labels the connected components of a graph (the weakly connected components of a directed graph).
+     *
+     * The edges are merged into a disjoint-set structure; large graphs are processed in parallel chunks using lock-free
+     * unions. Components are numbered in order of their smallest vertex, so vertex 0 is always in component 0.
+     *
+     * @param graph The graph.
+     * @return The component label of each vertex and the size of each component.
+     */
+    ConnectedComponents Algorithms::connectedComponents(const Graph& graph)
+    {
+        const size_t GRAIN_SIZE = 1 << 14;                  // The minimal number of vertices per parallel chunk
+
+        size_t numVertices = graph.getNumVertices();
+        const AdjacencyIndex& edges = graph.getOutEdges();  // Built before any thread starts
+        DisjointSet sets(numVertices);
+
+        // Merge the endpoints of every edge (lock-free unions when the graph is split between threads)
+        if (Parallel::getNumThreads() > 1 && numVertices >= 2 * GRAIN_SIZE)
+        {
+            Parallel::forRange(numVertices, GRAIN_SIZE, [&edges, &sets](size_t begin, size_t end)
+            {
+                for (size_t vertex_u = begin; vertex_u < end; vertex_u++)
+                {
+                    for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                    {
+                        sets.uniteConcurrent(vertex_u, edges.targets[e]);
+                    }
+                }
+            });
+        }
+        else
+        {
+            for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+            {
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                {
+                    sets.unite(vertex_u, edges.targets[e]);
+                }
+            }
+        }
+
+        // Number the components in order of their smallest vertex
+        ConnectedComponents result;
+        result.label.assign(numVertices, SIZE_MAX);
+        vector<size_t> rootLabel(numVertices, SIZE_MAX);
+        for (size_t v = 0; v < numVertices; v++)
+        {
+            size_t root = sets.find(v);
+            if (rootLabel[root] == SIZE_MAX)
+            {
+                rootLabel[root] = result.size.size();
+                result.size.push_back(0);
+            }
+            result.label[v] = rootLabel[root];
+            result.size[rootLabel[root]]++;
+        }
+
+        return result;
+    }
+
+
+    /**
+     * @brief This method computes the number of edges on the shortest paths from several sources to every vertex.
+     *
+     * The searches run as a multi-source BFS: up to 64 sources advance together, one bit per source per vertex, so every
+     * neighbour scan is shared by the whole batch. Batches run in parallel.
+     *
+     * @param graph The graph.
+     * @param sources The source vertices.
+     * @return For each source, the hop distance to every vertex (SIZE_MAX for unreachable vertices).
+     * @throws If a source is not a vertex of the graph throw invalid_argument exception
+     */
+    vector<vector<size_t>> Algorithms::hopDistances(const Graph& graph, const vector<size_t>& sources)
+    {
+        vector<vector<size_t>> distance(sources.size(), vector<size_t>(graph.getNumVertices(), SIZE_MAX));
+
+        multiSourceBfs(graph, sources, [&distance](size_t batch, size_t vertex, uint64_t found, size_t level)
+        {
+            while (found != 0)
+            {
+                distance[batch * 64 + static_cast<size_t>(__builtin_ctzll(found))][vertex] = level;
+                found &= found - 1;
+            }
+        });
+
+        return distance;
+    }
+
+
+    /**
+     * @brief This method computes the set of vertices reachable from each of several sources.
+     *
+     * The searches run as a multi-source BFS, 64 sources per batch (see hopDistances).
+     *
+     * @param graph The graph.
+     * @param sources The source vertices.
+     * @return For each source, a vector that marks the vertices reachable from it (including the source itself).
+     * @throws If a source is not a vertex of the graph throw invalid_argument exception
+     */
+    vector<vector<bool>> Algorithms::reachability(const Graph& graph, const vector<size_t>& sources)
+    {
+        vector<vector<bool>> reachable(sources.size(), vector<bool>(graph.getNumVertices(), false));
+
+        // NOTE: Every source has its own row, so concurrent batches never write to the same vector
+        multiSourceBfs(graph, sources, [&reachable](size_t batch, size_t vertex, uint64_t found, size_t)
+        {
+            while (found != 0)
+            {
+                reachable[batch * 64 + static_cast<size_t>(__builtin_ctzll(found))][vertex] = true;
+                found &= found - 1;
+            }
+        });
+
+        return reachable;
+    }
+
+
+    /**
+     * @brief This method builds the condensation of a graph: the DAG with one vertex per strongly connected component.
+     *
+     * Time complexity: O(|V|+|E|). Vertex i of the result is component i of stronglyConnectedComponents, and the edges
+     * between two components are merged into a single edge weighted by the lightest of them. The result uses dense
+     * storage when the matrix is not larger than the sparse index, and sparse storage otherwise.
+     *
+     * @param graph The graph.
+     * @return The condensed graph (an empty graph if the given graph has no vertices).
+     */
+    Graph Algorithms::condensation(const Graph& graph)
+    {
+        size_t numVertices = graph.getNumVertices();
+        if (numVertices == 0)
+        {
+            return Graph();
+        }
+
+        const AdjacencyIndex& outEdges = graph.getOutEdges();
+        vector<size_t> component = stronglyConnectedComponents(graph);
+        size_t numComponents = *max_element(component.begin(), component.end()) + 1;
+
+        // Group the vertices by component (counting sort)
+        vector<size_t> firstMember(numComponents + 1, 0);
+        vector<size_t> members(numVertices);
+        for (size_t v = 0; v < numVertices; v++)
+        {
+            firstMember[component[v] + 1]++;
+        }
+        for (size_t c = 0; c < numComponents; c++)
+        {
+            firstMember[c + 1] += firstMember[c];
+        }
+        vector<size_t> nextMember(firstMember.begin(), firstMember.end() - 1);
+        for (size_t v = 0; v < numVertices; v++)
+        {
+            members[nextMember[component[v]]++] = v;
+        }
+
+        // Collect the edges leaving each component, merging the edges that lead to the same component
+        vector<Edge> edges;
+        vector<size_t> edgeTo(numComponents, SIZE_MAX);     // The position in edges of the last edge added towards each component
+        for (size_t c = 0; c < numComponents; c++)
+        {
+            for (size_t m = firstMember[c]; m < firstMember[c + 1]; m++)
+            {
+                size_t vertex_u = members[m];
+                for (size_t e = outEdges.offsets[vertex_u]; e < outEdges.offsets[vertex_u + 1]; e++)
+                {
+                    size_t target = component[outEdges.targets[e]];
+                    if (target == c)
+                    {
+                        continue;
+                    }
+                    if (edgeTo[target] == SIZE_MAX || edges[edgeTo[target]].source != c)
+                    {
+                        edgeTo[target] = edges.size();
+                        edges.push_back(Edge{c, target, outEdges.weights[e]});
+                    }
+                    else
+                    {
+                        edges[edgeTo[target]].weight = min(edges[edgeTo[target]].weight, outEdges.weights[e]);
+                    }
+                }
+            }
+        }
+
+        // A dense matrix takes 4 bytes per cell, the sparse index about 8 bytes per vertex and per edge
+        if (numComponents * numComponents <= 2 * (numComponents + 1 + edges.size()))
+        {
+            vector<vector<int>> matrix(numComponents, vector<int>(numComponents, 0));
+            for (size_t i = 0; i < edges.size(); i++)
+            {
+                matrix[edges[i].source][edges[i].target] = edges[i].weight;
+            }
+            Graph condensed;
+            condensed.loadGraph(matrix);
+            return condensed;
+        }
+
+        return Graph::fromEdges(numComponents, edges);
+    }
+
+
+    /**
+     * @brief This method finds the shortest path between two vertices in a given graph.
+     *
+     * @note: The method uses a strategy to choose the appropriate algorithm based on the properties of the graph (weighted/unweighted, containts negative edges or not).
+     * It uses bidirectional BFS for unweighted graphs (time complexity: O(|V|+|E|)), Bellman-Ford for graphs with negative weights (time complexity: O(|V|*|E|)), 
+     * or Dijkstra's for non-negative weighted graphs (time complexity: O(|V|*|V|) for dense graphs; for sparse graphs O(|E|+|V|*C) with buckets
+     * when the largest weight C is small, O(|E|+|V|*log(C)) with a radix heap when it is moderate, O((|V|+|E|)*log|V|) with a bidirectional
+     * search over binary heaps otherwise), and thus does not waste resources. Sparse graphs with an ALT landmark index (built on
+     * request, see Graph::getLandmarks) are searched with A*. A graph with a contraction hierarchy (see
+     * Graph::getContractionHierarchy) is queried through the hierarchy instead. Graphs with at least 65536 vertices are searched
+     * by all the threads (see Parallel): with a parallel Bellman-Ford if there are negative weights, and with delta-stepping
+     * otherwise, unless several threads are not available or a landmark index was built (see Graph::getLandmarks).
+     *
+     * @param graph The graph.
+     * @param start The start vertex.
+     * @param end The end vertex.
+     * @return A string representing the path or a message if the path doesn't exist (see formatPath).
+     */
+    string Algorithms::shortestPath(const Graph& graph, size_t start, size_t end) 
+    {
+        PathResult result;
+        shortestPath(graph, start, end, result);
+        return formatPath(result);
+    }
+
+
+    /**
+     * @brief This method finds the shortest path between two vertices in a given graph, as in shortestPath above.
+     *
+     * The result is written into a buffer owned by the caller, so repeated queries reuse the memory of its path.
+     *
+     * @param graph The graph.
+     * @param start The start vertex.
+     * @param end The end vertex.
+     * @param result Filled with the status, the distance and the vertices of the path.
+     */
+    void Algorithms::shortestPath(const Graph& graph, size_t start, size_t end, PathResult& result) 
+    {
+        size_t numVertices = graph.getNumVertices();
+        result.status = PathStatus::NoPath;
+        result.start = start;
+        result.end = end;
+        result.distance = 0;
+        result.path.clear();
+
+        // Error checking no. 1
+        if (start >= numVertices || end >= numVertices) 
+        {
+            result.status = PathStatus::InvalidVertex;
+            return;
+        }
+
+        // Error checking no. 2
+        if (start == end) 
+        {
+            result.status = PathStatus::SameVertex;
+            return;
+        }
+
+        // A hierarchy is only built on request (and only for non-negative weights), so it always wins when it exists
+        if (graph.hasContractionHierarchy())
+        {
+            contractionHierarchyShortestPath(graph, start, end, graph.getContractionHierarchy(), result);
+            return;
+        }
+
+        // Check if the graph is unweighted and has negative edges to choose the relevant algorithm to run
+        pair<bool, bool> graphType = checkGraphType(graph);
+        bool isUnweighted = graphType.first;
+        bool hasNegativeEdges = graphType.second;
+
+        // Choose the algorithm based on the graph's type
+        // NOTE: BFS and Dijkstra return the same path on the whole graph as on the extracted sub-graph (every parent of a vertex
+        // that leads to end leads to end as well), and their searches already stay near the path, so only Bellman-Ford needs it
+        if (isUnweighted) 
+        {
+            bfsShortestPath(graph, start, end, result);
+            return;
+        } 
+        if (hasNegativeEdges) 
+        {
+            // Extract sub-graph that contains both the start and end vertices
+            Graph subgraph;
+            extractSubgraph(graph, start, end, subgraph);
+            if (numVertices >= PARALLEL_SSSP_MIN_VERTICES)
+            {
+                parallelBellmanFordShortestPath(subgraph, start, end, result);
+                return;
+            }
+            bellmanFordShortestPath(subgraph, start, end, result);
+            return;
+        } 
+
+        // A heap pays O(log|V|) per edge, the array version O(|V|) per vertex
+        if (graph.getOutEdges().numEntries() * DENSE_DIJKSTRA_RATIO >= numVertices * numVertices)
+        {
+            dijkstraShortestPath(graph, start, end, result);
+            return;
+        }
+
+        // On very large graphs one search spread over all the threads costs less than the 16 searches that build a landmark
+        // index, so the index is only used there once it was built on request (see Graph::getLandmarks)
+        if (!graph.hasLandmarks() && Parallel::getNumThreads() > 1 && numVertices >= PARALLEL_SSSP_MIN_VERTICES)
+        {
+            deltaSteppingShortestPath(graph, start, end, result);
+            return;
+        }
+
+        // A landmark index costs 16 searches, so it is never built by a query; once it exists it steers every query towards end
+        if (graph.hasLandmarks())
+        {
+            landmarkShortestPath(graph, start, end, graph.getLandmarks(), result);
+            return;
+        }
+
+        // Small integer weights allow monotone integer priority queues (the weight range is cached by the graph)
+        int maxWeight = graph.getMaxWeight();
+        if (maxWeight <= DIAL_MAX_WEIGHT)
+        {
+            dialShortestPath(graph, start, end, maxWeight, result);
+            return;
+        }
+        if (maxWeight <= RADIX_HEAP_MAX_WEIGHT)
+        {
+            radixHeapShortestPath(graph, start, end, result);
+            return;
+        }
+        bidirectionalDijkstraShortestPath(graph, start, end, result);
+    }
+
+
+    /**
+     * @brief This method formats the result of a shortest path query as a string, e.g. "0->3->5".
+     *
+     * @param result The result of the query.
+     * @return A string representing the path or a message if the path doesn't exist.
+     */
+    string Algorithms::formatPath(const PathResult& result)
+    {
+        switch (result.status)
+        {
+            case PathStatus::InvalidVertex:
+                return "Invalid start or end vertex";
+            case PathStatus::SameVertex:
+                return "No path exists between a vertex and itself";
+            case PathStatus::NegativeCycle:
+                return "Graph contains a negative cycle";
+            case PathStatus::NoPath:
+                return "No path exists between " + to_string(result.start) + " and " + to_string(result.end);
+            case PathStatus::Found:
+                break;
+        }
+
+        // Append the vertices in order (the string is built once, not shifted for every vertex)
+        return joinVertices(result.path);
+    }
+
+
+    /**
+     * @brief This method computes the shortest paths from a vertex to every vertex of a given graph.
+     *
+     * The search is chosen as in shortestPath: BFS for unweighted graphs, Bellman-Ford for graphs with negative weights, and
+     * Dijkstra's with a binary heap otherwise (time complexity: O((|V|+|E|)*log|V|)), or delta-stepping on all the threads
+     * for graphs with at least 65536 vertices (see Parallel). Without negative weights the parent of a vertex is its
+     * in-neighbour on a shortest path with the smallest (distance, index), so the paths are the ones shortestPath returns;
+     * with negative weights they are the ones Bellman-Ford finds. One search replaces a query per target (see treePath).
+     *
+     * @param graph The graph.
+     * @param source The vertex to start from.
+     * @return The distance and the parent of every vertex, or an indication of a negative cycle.
+     * @throws If the source is not a vertex of the graph throw invalid_argument exception
+     */
+    ShortestPathTree Algorithms::singleSourceShortestPaths(const Graph& graph, size_t source)
+    {
+        size_t numVertices = graph.getNumVertices();
+        if (source >= numVertices)
+        {
+            throw invalid_argument("Invalid source vertex " + to_string(source));
+        }
+
+        ShortestPathTree tree;
+        tree.source = source;
+        tree.hasNegativeCycle = false;
+
+        // Check if the graph is unweighted and has negative edges to choose the relevant algorithm to run
+        pair<bool, bool> graphType = checkGraphType(graph);
+        bool isUnweighted = graphType.first;
+        bool hasNegativeEdges = graphType.second;
+        const AdjacencyIndex& edges = graph.getOutEdges();
+
+        if (hasNegativeEdges)
+        {
+            tree.hasNegativeCycle = !bellmanFordTree(graph, source, tree.distance, tree.parent);
+            if (tree.hasNegativeCycle)
+            {
+                tree.distance.assign(numVertices, LLONG_MAX);
+                tree.parent.assign(numVertices, SIZE_MAX);
+            }
+            return tree;
+        }
+
+        if (isUnweighted)
+        {
+            // Every edge weighs 1, so the levels of a BFS are the distances
+            tree.distance.assign(numVertices, LLONG_MAX);
+            tree.distance[source] = 0;
+            vector<size_t> order(1, source);
+            for (size_t i = 0; i < order.size(); i++)
+            {
+                size_t vertex_u = order[i];
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                {
+                    size_t vertex_v = edges.targets[e];
+                    if (tree.distance[vertex_v] == LLONG_MAX)
+                    {
+                        tree.distance[vertex_v] = tree.distance[vertex_u] + 1;
+                        order.push_back(vertex_v);
+                    }
+                }
+            }
+        }
+        else if (Parallel::getNumThreads() > 1 && numVertices >= PARALLEL_SSSP_MIN_VERTICES)
+        {
+            deltaSteppingDistances(graph, source, numVertices, tree.distance);
+        }
+        else
+        {
+            tree.distance.assign(numVertices, LLONG_MAX);
+            tree.distance[source] = 0;
+            priority_queue<pair<long long, size_t>, vector<pair<long long, size_t>>, greater<pair<long long, size_t>>> heap;
+            heap.push(make_pair(0LL, source));
+            while (!heap.empty())
+            {
+                long long key = heap.top().first;
+                size_t vertex_u = heap.top().second;
+                heap.pop();
+
+                // Skip stale entries of vertices that were already settled
+                if (key > tree.distance[vertex_u])
+                {
+                    continue;
+                }
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                {
+                    size_t vertex_v = edges.targets[e];
+                    long long candidate = key + edges.weights[e];
+                    if (candidate < tree.distance[vertex_v])
+                    {
+                        tree.distance[vertex_v] = candidate;
+                        heap.push(make_pair(candidate, vertex_v));
+                    }
+                }
+            }
+        }
+
+        // Every weight is positive, so the tight in-neighbours with the smallest (distance, index) lead back to the source
+        const AdjacencyIndex& inEdges = graph.getInEdges();
+        tree.parent.assign(numVertices, SIZE_MAX);
+        for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++)
+        {
+            if (vertex_v == source || tree.distance[vertex_v] == LLONG_MAX)
+            {
+                continue;
+            }
+            long long bestDistance = LLONG_MAX;
+            for (size_t e = inEdges.offsets[vertex_v]; e < inEdges.offsets[vertex_v + 1]; e++)
+            {
+                size_t vertex_u = inEdges.targets[e];
+                long long distance_u = tree.distance[vertex_u];
+                if (distance_u != LLONG_MAX && distance_u + inEdges.weights[e] == tree.distance[vertex_v] && distance_u < bestDistance)
+                {
+                    tree.parent[vertex_v] = vertex_u;
+                    bestDistance = distance_u;
+                }
+            }
+        }
+        return tree;
+    }
+
+
+    /**
+     * @brief This method reads the shortest path to a vertex from a shortest path tree (time complexity: O(length of the path)).
+     *
+     * The statuses are the ones shortestPath reports, except that a negative cycle reachable from the source is reported
+     * for every end vertex.
+     *
+     * @param tree The shortest path tree (see singleSourceShortestPaths).
+     * @param end The end vertex.
+     * @param result Filled with the status, the distance and the vertices of the path.
+     */
+    void Algorithms::treePath(const ShortestPathTree& tree, size_t end, PathResult& result)
+    {
+        result.start = tree.source;
+        result.end = end;
+        result.distance = 0;
+        result.path.clear();
+
+        if (end >= tree.distance.size())
+        {
+            result.status = PathStatus::InvalidVertex;
+            return;
+        }
+        if (end == tree.source)
+        {
+            result.status = PathStatus::SameVertex;
+            return;
+        }
+        if (tree.hasNegativeCycle)
+        {
+            result.status = PathStatus::NegativeCycle;
+            return;
+        }
+        if (tree.distance[end] == LLONG_MAX)
+        {
+            result.status = PathStatus::NoPath;
+            return;
+        }
+
+        // Walk back from end to the source, then put the path in order
+        result.status = PathStatus::Found;
+        result.distance = tree.distance[end];
+        for (size_t current = end; current != tree.source; current = tree.parent[current])
+        {
+            result.path.push_back(current);
+        }
+        result.path.push_back(tree.source);
+        reverse(result.path.begin(), result.path.end());
+    }
+
+     /**
+     * @brief This method checks if there is a cycle in the graph.
+     *
+     * This method uses DFS to find a back edge, which indicates a cycle.
+     *
+     * @param graph The graph to check.
+     * @return A string representing the cycle if one exists; otherwise, "0".
+     */
+    string Algorithms::isContainsCycle(const Graph& graph) 
+    {
+        CycleResult result;
+        isContainsCycle(graph, result);
+
+        // If a cyrcle wasn't found, return "0"
+        return result.found ? formatCycle(result) : "0"; 
+    }
+
+
+    /**
+     * @brief This method checks if there is a cycle in the graph, as in isContainsCycle above.
+     *
+     * @param graph The graph to check.
+     * @param result Filled with the vertices of the cycle, if one exists.
+     */
+    void Algorithms::isContainsCycle(const Graph& graph, CycleResult& result) 
+    {
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        size_t numVertices = graph.getNumVertices();        // A variable to store the number of vertices in the graph
+        vector<bool> visited(numVertices, false);           // A vector to track if each vertex visited
+        vector<bool> recStack(numVertices, false);          // A vector to track if a vertex is currently in the recursion (used by dfs_cycle)
+        vector<size_t> parent(numVertices, 0);              // A vector to track the parent of each vertex, used to build the cycle (if exists)
+        result.cycle.clear();
+
+        // Iterate over all unvisited vertices by DFS 
+        for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++) 
+        {
+            // If a cyrcle found, stop
+            if (!visited[vertex_v] && dfs_cycle(edges, vertex_v, visited, recStack, parent, graph.isGraphDirected(), result.cycle)) 
+            {
+                result.found = true;
+                return;
+            }
+        }
+        result.found = false;
+    }
+
+
+    /**
+     * @brief This method formats the result of a cycle query as a string, e.g. "0->1->2->0".
+     *
+     * @param result The result of the query.
+     * @return A string representing the cycle, or an empty string if no cycle was found.
+     */
+    string Algorithms::formatCycle(const CycleResult& result)
+    {
+        return joinVertices(result.cycle);
+    }
+    
+
+    /**
+     * @brief This function checks if a graph is bipartite.
+     *
+     * @note A graph is bipartite if it can be colored using two colors such that no two adjacent vertices with the same color.
+     * This function uses DFS to color the graph.
+     *
+     * @param graph The graph to check.
+     * @return A string indicating if the graph is bipartite; otherwise, an error message.
+     */
+    string Algorithms::isBipartite(const Graph& graph) 
+    {
+        BipartiteResult result;
+        isBipartite(graph, result);
+        return formatBipartition(result);
+    }
+
+
+    /**
+     * @brief This function checks if a graph is bipartite, as in isBipartite above.
+     *
+     * @param graph The graph to check.
+     * @param result Filled with the side of every vertex, if the graph is bipartite.
+     */
+    void Algorithms::isBipartite(const Graph& graph, BipartiteResult& result) 
+    {
+        const AdjacencyIndex& outEdges = graph.getOutEdges();
+        const AdjacencyIndex& inEdges = graph.getInEdges();
+        size_t numVertices = graph.getNumVertices();
+        result.label.assign(numVertices, -1);           // Uncolor (-1) all of the vertices
+
+        for (size_t i = 0; i < numVertices; ++i) 
+        {
+            // If a vertex is uncolored, start a new DFS
+            if (result.label[i] == -1 && !dfsCheck(outEdges, inEdges, i, result.label, 0)) 
+            {
+                result.isBipartite = false;
+                result.label.clear();
+                return;
+            }
+        }
+        result.isBipartite = true;
+    }
+
+
+    /**
+     * @brief This method formats the result of a bipartite query as a string, e.g. "The graph is bipartite: A={0,2}, B={1}".
+     *
+     * @param result The result of the query.
+     * @return A string indicating if the graph is bipartite; otherwise, an error message.
+     */
+    string Algorithms::formatBipartition(const BipartiteResult& result)
+    {
+        if (!result.isBipartite) 
+        {
+            return "The graph is not bipartite";
+        }
+
+        // Saperate the vertices based on their colors to two sets
+        vector<size_t> setA;
+        vector<size_t> setB;
+
+        for (size_t i = 0; i < result.label.size(); i++) 
+        {
+            if (result.label[i] == 0) 
+            {
+                setA.push_back(i);
+            }
+            else
+            {
+                setB.push_back(i);
+            }
+        }
+        
+        // Present the results as string
+        return "The graph is bipartite: A=" + buildSet(setA) + ", B=" + buildSet(setB);
+    }
+
+
+    /**
+     * @brief This method checks for a negative cycle in the graph.
+     *
+     * Negative self-loops and neighbours whose edges have different weights with a negative sum are checked first; longer
+     * cycles are found with Tarjan's subtree disassembly (see findNegativeCircle), which reports the first cycle it closes.
+     *
+     * @param graph The graph to check.
+     * @return A string represents a negative cycle if exists; otherwise, "No negative cycle exists".
+     */
+    string Algorithms::negativeCycle(const Graph& graph)
+    {
+        CycleResult result;
+        negativeCycle(graph, result);
+        return result.found ? formatCycle(result) : "No negative cycle exists";
+    }
+
+
+    /**
+     * @brief This method checks for a negative cycle in the graph, as in negativeCycle above.
+     *
+     * @param graph The graph to check.
+     * @param result Filled with the vertices of a negative cycle, if one exists.
+     */
+    void Algorithms::negativeCycle(const Graph& graph, CycleResult& result)
+    {
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        size_t numVertices = graph.getNumVertices();        // A variable to store the number of vertices in the graph
+
+        // Part 1: Check for negative self-loops
+        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++) 
+        {
+            if (edges.findWeight(vertex_u, vertex_u) < 0) 
+            {
+                result.found = true;
+                result.cycle.assign(2, vertex_u);
+                return;
+            }
+        }
+
+        // Part 2: Check for negative cycles between neighboring vertices with different edge weights
+        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++) 
+        {
+            for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++) 
+            {
+                size_t vertex_v = edges.targets[e];
+                int reverse = vertex_v != vertex_u ? edges.findWeight(vertex_v, vertex_u) : 0;
+
+                // Check if there are differing weights in the edges u->v and v->u that sum to a negative value
+                if (reverse != 0 && reverse != edges.weights[e] && static_cast<long long>(reverse) + edges.weights[e] < 0) 
+                {
+                    result.found = true;
+                    result.cycle.assign(3, vertex_u);
+                    result.cycle[1] = vertex_v;
+                    return;
+                }
+            }
+        }
+
+        // Part 3: Check for negative cycles with with path involves more than one edge
+        vector<long long> distance;
+        result.found = findNegativeCircle(graph, false, distance, result.cycle);
+    }
+
+
+
+    /**
+     * @brief This method computes the shortest paths between all pairs of vertices.
+     *
+     * Dense graphs use a cache-blocked Floyd-Warshall (time complexity: O(|V|^3)) that splits every round between the threads
+     * (see Parallel). When no path can overflow an int, four distances are relaxed at a time with SSE2; otherwise the
+     * distances are long long. A negative distance from a vertex to itself means a negative cycle, which stops the search.
+     * Sparse graphs (fewer than |V|^2/16 edges) use Johnson's algorithm instead (time complexity: O(|V|*|E|*log|V|)). Every
+     * closed walk counts, so an undirected edge with a negative weight is a negative cycle here (unlike in negativeCycle).
+     *
+     * @param graph The graph.
+     * @return The distance and the next hop between every pair of vertices, or an indication of a negative cycle.
+     */
+    AllPairsShortestPaths Algorithms::allPairsShortestPaths(const Graph& graph)
+    {
+        size_t numVertices = graph.getNumVertices();
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        // A Dijkstra's search per vertex pays O(log|V|) per edge, Floyd-Warshall O(|V|) per pair
+        if (edges.numEntries() * DENSE_DIJKSTRA_RATIO < numVertices * numVertices)
+        {
+            return johnsonShortestPaths(graph);
+        }
+
+        AllPairsShortestPaths result;
+        result.hasNegativeCycle = false;
+
+        // Every simple path is shorter than (|V| - 1) times the largest absolute weight
+        long long largestWeight = max(llabs(graph.getMinWeight()), llabs(graph.getMaxWeight()));
+        if (largestWeight * static_cast<long long>(numVertices) < FLOYD_INT_INFINITY)
+        {
+            floydWarshall<int>(edges, numVertices, FLOYD_INT_INFINITY, result);
+        }
+        else
+        {
+            floydWarshall<long long>(edges, numVertices, LLONG_MAX / 2, result);
+        }
+        return result;
+    }
+
+
+    /**
+     * @brief This method computes the number of edges on the shortest paths between all pairs of vertices.
+     *
+     * Dense undirected graphs (at least |V|^2/4 edges) use Seidel's algorithm: O(log|V|) boolean matrix products on bitmaps,
+     * 8 rows per table lookup (time complexity: O(|V|^3*log|V|/(64*8))). Other graphs run a multi-source BFS from every
+     * vertex (see hopDistances). The weights are ignored, as in hopDistances.
+     *
+     * @param graph The graph.
+     * @return For each vertex, the hop distance to every vertex (SIZE_MAX for unreachable vertices).
+     */
+    vector<vector<size_t>> Algorithms::allPairsHopDistances(const Graph& graph)
+    {
+        size_t numVertices = graph.getNumVertices();
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        // Seidel's algorithm needs symmetric edges, and on sparse graphs a BFS scans far fewer edges than a product
+        if (graph.isGraphDirected() || edges.numEntries() * SEIDEL_DENSITY_RATIO < numVertices * numVertices)
+        {
+            vector<size_t> sources(numVertices);
+            for (size_t vertex = 0; vertex < numVertices; vertex++)
+            {
+                sources[vertex] = vertex;
+            }
+            return hopDistances(graph, sources);
+        }
+
+        return seidelHopDistances(edges, numVertices);
+    }
+
+
+
+    /*********************************************/
+    ///             PRIVATE SECTION             ///
+    /*********************************************/
+
+    /**
+     * @brief This auxiliary function performs BFS on the graph starting from the given vertex.
+     * It can also be used to find the shortest path by tracking the parent of each vertex.
+     *
+     * @param graph The graph to perform BFS on.
+     * @param startVertex The starting vertex for BFS.
+     * @param visited A vector to track visited vertices.
+     * @param parent A vector to track the parent of the vertices (extents the classic BFS for finding the shortest path).
+     * @param parent A vector to track the parent of each vertex, used for rebuilding paths (extents the classic BFS for finding the shortest path).
+     */
+    void Algorithms::bfs(const Graph& graph, size_t startVertex, vector<bool>& visited, vector<size_t>& parent, size_t end, bool reverse = false) 
+    {
+        // Build both indexes before the search shares them between threads
+        const AdjacencyIndex& outEdges = graph.getOutEdges();
+        const AdjacencyIndex& inEdges = graph.getInEdges();
+
+        // NOTE: A reverse BFS (used to extract the sub-graph for shortest paths) follows the edges backwards
+        vector<uint64_t> reached;
+        directionOptimizingBfs(reverse ? inEdges : outEdges, reverse ? outEdges : inEdges, startVertex, end, reached, parent);
+
+        for (size_t i = 0; i < graph.getNumVertices(); i++)
+        {
+            if (testBit(reached, i))
+            {
+                visited[i] = true;
+            }
+        }
+    }
+
+    /**
+     * @brief This auxiliary function runs a multi-source BFS from batches of up to 64 sources.
+     *
+     * Bit i of a vertex's masks belongs to source batch * 64 + i. Each level, every vertex with active bits pushes them
+     * to its neighbours that have not seen them yet. Batches are independent and run in parallel.
+     *
+     * @param graph The graph.
+     * @param sources The source vertices.
+     * @param visit Called once per vertex and level with the bits of the sources that reach the vertex at that level
+     * (the arguments are the batch, the vertex, the bits and the level); calls from different batches may run concurrently.
+     * @throws If a source is not a vertex of the graph throw invalid_argument exception
+     */
+    void Algorithms::multiSourceBfs(const Graph& graph, const vector<size_t>& sources, const function<void(size_t, size_t, uint64_t, size_t)>& visit)
+    {
+        size_t numVertices = graph.getNumVertices();
+        for (size_t i = 0; i < sources.size(); i++)
+        {
+            if (sources[i] >= numVertices)
+            {
+                throw invalid_argument("Invalid source vertex " + to_string(sources[i]));
+            }
+        }
+
+        const AdjacencyIndex& edges = graph.getOutEdges();      // Built before any thread starts
+        size_t numBatches = (sources.size() + 63) / 64;
+
+        Parallel::forRange(numBatches, 1, [&](size_t beginBatch, size_t endBatch)
+        {
+            vector<uint64_t> seen(numVertices);         // The sources that already reached each vertex
+            vector<uint64_t> active(numVertices);       // The sources that reached each vertex in the current level
+            vector<uint64_t> reached(numVertices);      // The sources that reach each vertex in the next level
+
+            for (size_t batch = beginBatch; batch < endBatch; batch++)
+            {
+                fill(seen.begin(), seen.end(), 0);
+                fill(active.begin(), active.end(), 0);
+                size_t batchSize = min<size_t>(64, sources.size() - batch * 64);
+                for (size_t i = 0; i < batchSize; i++)
+                {
+                    size_t source = sources[batch * 64 + i];
+                    seen[source] |= uint64_t(1) << i;
+                    active[source] |= uint64_t(1) << i;
+                }
+                for (size_t v = 0; v < numVertices; v++)
+                {
+                    if (active[v] != 0)
+                    {
+                        visit(batch, v, active[v], 0);
+                    }
+                }
+
+                for (size_t level = 1; ; level++)
+                {
+                    // Push the active sources of every vertex along its edges (one scan serves the whole batch)
+                    fill(reached.begin(), reached.end(), 0);
+                    for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+                    {
+                        if (active[vertex_u] == 0)
+                        {
+                            continue;
+                        }
+                        for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                        {
+                            size_t vertex_v = edges.targets[e];
+                            reached[vertex_v] |= active[vertex_u] & ~seen[vertex_v];
+                        }
+                    }
+
+                    // Keep only the sources that are new to each vertex
+                    bool progress = false;
+                    for (size_t v = 0; v < numVertices; v++)
+                    {
+                        uint64_t found = reached[v] & ~seen[v];
+                        active[v] = found;
+                        if (found != 0)
+                        {
+                            seen[v] |= found;
+                            visit(batch, v, found, level);
+                            progress = true;
+                        }
+                    }
+                    if (!progress)
+                    {
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+
+    /**
+     * @brief This auxiliary function extracts a subgraph from the given graph, 
+     * containing only nodes and edges that form possible paths from the start to the end vertex.
+     *
+     * The function uses two breadth-first searches (BFS):
+     * 1. A forward BFS from the start vertex to identify all nodes reachable from the start.
+     * 2. A reverse BFS from the end vertex to identify all nodes that can lead to the end.
+     * The intersection of these nodes create the set of relevant nodes in the subgraph.
+     *
+     * @param graph The original graph from which the subgraph is to be extracted.
+     * @param start The starting vertex for potential paths.
+     * @param end The ending vertex for potential paths.
+     * @param subgraph A Graph object that will be populated with the resulting subgraph.
+     */
+    void Algorithms::extractSubgraph(const Graph& graph, size_t start, size_t end, Graph& subgraph) 
+    {
+        size_t numVertices = graph.getNumVertices();            // A variable to store the number of vertices in the original graph
+        vector<bool> reachableFromStart(numVertices, false);    // A vector to track which nodes are reachable from the start vertex
+        vector<bool> leadsToEnd(numVertices, false);            // A vector to tracks which nodes can lead to the end vertex
+        vector<size_t> parent(numVertices, SIZE_MAX);           // Dummy parent vector for BFS, not used here but necessary for the bfs function signature
+
+
+        bfs(graph, start, reachableFromStart, parent, SIZE_MAX, false);     // BFS from the start vertex to find all reachable nodes
+        bfs(graph, end, leadsToEnd, parent, SIZE_MAX, true);                // Reverse BFS from the end vertex on the reverse graph to find all nodes leading to the end
+
+
+        // Collect the edges that connect nodes that are both reachable from start and can lead to end
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        vector<Edge> subgraphEdges;
+        for (size_t i = 0; i < numVertices; i++) 
+        {
+            if (reachableFromStart[i] && leadsToEnd[i]) 
+            {
+                for (size_t e = edges.offsets[i]; e < edges.offsets[i + 1]; e++) 
+                {
+                    size_t j = edges.targets[e];
+                    if (reachableFromStart[j] && leadsToEnd[j]) 
+                    {
+                        subgraphEdges.push_back(Edge{i, j, edges.weights[e]});
+                    }
+                }
+            }
+        }
+
+        // Large sparse subgraphs are stored sparsely (a dense matrix takes 4 bytes per cell, the sparse index about 8 bytes per vertex and per edge)
+        if (numVertices * numVertices > 2 * (numVertices + 1 + subgraphEdges.size()))
+        {
+            subgraph = Graph::fromEdges(numVertices, subgraphEdges);
+            return;
+        }
+
+        // Load the resulted matrix into the subgraph Graph that pass to the function as reference
+        vector<vector<int>> subgraphMat(numVertices, vector<int>(numVertices, 0));
+        for (size_t i = 0; i < subgraphEdges.size(); i++) 
+        {
+            subgraphMat[subgraphEdges[i].source][subgraphEdges[i].target] = subgraphEdges[i].weight;
+        }
+        subgraph.loadGraph(subgraphMat);
+    }
+
+
+    /**
+     * @brief This auxiliary function finds the shortest path using a bidirectional BFS for unweighted graphs.
+     *
+     * A forward search from start (over the out-edges) and a backward search from end (over the in-edges) expand a
+     * whole level at a time, always on the side with the smaller frontier, and stop once the sum of their depths
+     * reaches the length of the shortest path seen so far. The path is rebuilt by buildBidirectionalPath.
+     *
+     * @param graph The graph.
+     * @param start The start vertex.
+     * @param end The end vertex.
+     * @param result Filled with the status, the distance and the path.
+     */
+    void Algorithms::bfsShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result) 
+    {
+        const AdjacencyIndex& outEdges = graph.getOutEdges();
+        const AdjacencyIndex& inEdges = graph.getInEdges();
+        size_t numVertices = graph.getNumVertices();
+        vector<long long> forward(numVertices, LLONG_MAX);      // The level of every vertex reached from start
+        vector<long long> backward(numVertices, LLONG_MAX);     // The level of every vertex that reaches end
+        vector<size_t> forwardReached(1, start);
+        vector<size_t> forwardFrontier(1, start);
+        vector<size_t> backwardFrontier(1, end);
+        vector<size_t> next;
+        long long forwardLevel = 0;
+        long long backwardLevel = 0;
+        long long best = LLONG_MAX;                             // The length of the shortest path seen so far
+
+        forward[start] = 0;
+        backward[end] = 0;
+
+        // A shortest path has a vertex at every level, so once the levels add up to its length both sides have seen it
+        while (!forwardFrontier.empty() && !backwardFrontier.empty() && (best == LLONG_MAX || forwardLevel + backwardLevel < best)) 
+        {
+            bool isForward = forwardFrontier.size() <= backwardFrontier.size();
+            const AdjacencyIndex& edges = isForward ? outEdges : inEdges;
+            vector<long long>& own = isForward ? forward : backward;
+            const vector<long long>& other = isForward ? backward : forward;
+            vector<size_t>& frontier = isForward ? forwardFrontier : backwardFrontier;
+            long long level = isForward ? ++forwardLevel : ++backwardLevel;
+
+            next.clear();
+            for (size_t i = 0; i < frontier.size(); i++) 
+            {
+                size_t vertex_u = frontier[i];
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++) 
+                {
+                    size_t vertex_v = edges.targets[e];
+                    if (own[vertex_v] != LLONG_MAX) 
+                    {
+                        continue;
+                    }
+                    own[vertex_v] = level;
+                    next.push_back(vertex_v);
+                    if (other[vertex_v] != LLONG_MAX) 
+                    {
+                        best = min(best, level + other[vertex_v]);
+                    }
+                }
+            }
+            if (isForward) 
+            {
+                forwardReached.insert(forwardReached.end(), next.begin(), next.end());
+            }
+            frontier.swap(next);
+        }
+
+        if (best == LLONG_MAX) 
+        {
+            result.status = PathStatus::NoPath;
+            return;
+        }
+
+        // Build the shortest path
+        result.status = PathStatus::Found;
+        result.distance = best;
+        buildBidirectionalPath(graph, start, end, best, forward, backward, forwardReached, result.path);
+    }
+
+
+    /**
+     * @brief This auxiliary function rebuilds the path found by a bidirectional search.
+     *
+     * It returns the same path as a forward search from start: the parent of a vertex is its in-neighbour on a shortest
+     * path with the smallest (distance from start, index). First the vertices on shortest paths are marked, starting at the
+     * places where the two searches meet and following the edges that are tight in either search; then the path is
+     * walked back from end.
+     *
+     * @param graph The graph.
+     * @param start The start vertex.
+     * @param end The end vertex.
+     * @param length The length of the shortest path.
+     * @param forward The exact distance from start of every vertex settled by the forward search (LLONG_MAX for others).
+     * @param backward The exact distance to end of every vertex settled by the backward search (LLONG_MAX for others).
+     * @param forwardSettled The vertices settled by the forward search.
+     * @param path Filled with the vertices of the path from start to end.
+     */
+    void Algorithms::buildBidirectionalPath(const Graph& graph, size_t start, size_t end, long long length, const vector<long long>& forward,
+                                            const vector<long long>& backward, const vector<size_t>& forwardSettled, vector<size_t>& path)
+    {
+        const AdjacencyIndex& outEdges = graph.getOutEdges();
+        const AdjacencyIndex& inEdges = graph.getInEdges();
+        vector<char> onPath(graph.getNumVertices(), 0);
+        vector<size_t> pending;
+
+        // The searches meet at vertices settled by both sides, or at edges from the forward side to the backward side
+        for (size_t i = 0; i < forwardSettled.size(); i++) 
+        {
+            size_t vertex_u = forwardSettled[i];
+            if (backward[vertex_u] != LLONG_MAX && forward[vertex_u] + backward[vertex_u] == length && !onPath[vertex_u]) 
+            {
+                onPath[vertex_u] = 1;
+                pending.push_back(vertex_u);
+            }
+            for (size_t e = outEdges.offsets[vertex_u]; e < outEdges.offsets[vertex_u + 1]; e++) 
+            {
+                size_t vertex_v = outEdges.targets[e];
+                if (backward[vertex_v] == LLONG_MAX || forward[vertex_u] + outEdges.weights[e] + backward[vertex_v] != length) 
+                {
+                    continue;
+                }
+                if (!onPath[vertex_u]) 
+                {
+                    onPath[vertex_u] = 1;
+                    pending.push_back(vertex_u);
+                }
+                if (!onPath[vertex_v]) 
+                {
+                    onPath[vertex_v] = 1;
+                    pending.push_back(vertex_v);
+                }
+            }
+        }
+
+        // Spread the marks along tight edges: backwards on the forward side, forwards on the backward side
+        while (!pending.empty()) 
+        {
+            size_t vertex_u = pending.back();
+            pending.pop_back();
+            if (forward[vertex_u] != LLONG_MAX) 
+            {
+                for (size_t e = inEdges.offsets[vertex_u]; e < inEdges.offsets[vertex_u + 1]; e++) 
+                {
+                    size_t vertex_w = inEdges.targets[e];
+                    if (!onPath[vertex_w] && forward[vertex_w] != LLONG_MAX && forward[vertex_w] + inEdges.weights[e] == forward[vertex_u]) 
+                    {
+                        onPath[vertex_w] = 1;
+                        pending.push_back(vertex_w);
+                    }
+                }
+            }
+            if (backward[vertex_u] != LLONG_MAX) 
+            {
+                for (size_t e = outEdges.offsets[vertex_u]; e < outEdges.offsets[vertex_u + 1]; e++) 
+                {
+                    size_t vertex_w = outEdges.targets[e];
+                    if (!onPath[vertex_w] && backward[vertex_w] != LLONG_MAX && backward[vertex_w] + outEdges.weights[e] == backward[vertex_u]) 
+                    {
+                        onPath[vertex_w] = 1;
+                        pending.push_back(vertex_w);
+                    }
+                }
+            }
+        }
+
+        // Walk back from end, choosing the parent a forward search would choose
+        path.assign(1, end);
+        size_t current = end;
+        long long currentDistance = length;
+        while (current != start) 
+        {
+            size_t bestParent = SIZE_MAX;
+            long long bestDistance = LLONG_MAX;
+            for (size_t e = inEdges.offsets[current]; e < inEdges.offsets[current + 1]; e++) 
+            {
+                size_t vertex_u = inEdges.targets[e];
+                if (!onPath[vertex_u]) 
+                {
+                    continue;
+                }
+                long long distance_u = forward[vertex_u] != LLONG_MAX ? forward[vertex_u] : length - backward[vertex_u];
+                if (distance_u + inEdges.weights[e] == currentDistance && (distance_u < bestDistance || (distance_u == bestDistance && vertex_u < bestParent))) 
+                {
+                    bestParent = vertex_u;
+                    bestDistance = distance_u;
+                }
+            }
+            path.push_back(bestParent);
+            current = bestParent;
+            currentDistance = bestDistance;
+        }
+        reverse(path.begin(), path.end());
+    }
+
+
+    /**
+     * @brief This auxiliary function finds the shortest path in a graph with possible negative weights using Bellman-Ford algorithm.
+     *
+     * This algorithm also checks for negative cycles and if detected, reports one in the result (see bellmanFordTree).
+     *
+     * @param graph The graph.
+     * @param start The starting vertex.
+     * @param end The destination vertex.
+     * @param result Filled with the status, the distance and the path.
+     */
+    void Algorithms::bellmanFordShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result)
+    {
+        vector<long long> distance;
+        vector<size_t> parent;
+        if (!bellmanFordTree(graph, start, distance, parent))
+        {
+            result.status = PathStatus::NegativeCycle;
+            return;
+        }
+
+        // Check if the distance from start to end remains infinity
+        if (distance[end] == LLONG_MAX)
         {
-            if (!visited[i]) 
-            {
-                return false; 
-            }
+            result.status = PathStatus::NoPath;
+            return;
         }
 
-        return true;
+        // Build the shortest path
+        result.status = PathStatus::Found;
+        result.distance = distance[end];
+        buildPath(start, end, parent, result.path);
     }
 
 
     /**
-     * This function checks if a given graph is strongly connected by applying BFS from each vertex.
+     * @brief This auxiliary function computes the distances from a vertex with Bellman-Ford algorithm, and their shortest path tree.
      *
-     * @param graph The graph to check.
-     * @return true if the graph is strongly connected; otherwise, false.
+     * Instead of relaxing every edge V-1 times, each pass rescans only the vertices whose distance changed (in index order,
+     * so the result is the same as relaxing all the edges), and the search stops after the first quiet pass. A negative
+     * cycle is reported as soon as a vertex is reached by a walk of V edges, or if the V-th pass still relaxes an edge.
+     * The passes never relax an edge back to the parent, so every vertex is checked for such short cycles when it is
+     * first reached.
+     *
+     * @param graph The graph.
+     * @param source The vertex to start from.
+     * @param distance Filled with the distance of every vertex from the source (LLONG_MAX for unreachable vertices).
+     * @param parent Filled with the parent of every vertex (SIZE_MAX for the source and unreachable vertices).
+     * @return false if a negative cycle is reachable from the source; otherwise, true.
      */
-    bool Algorithms::isStronglyConnected(Graph& graph) 
+    bool Algorithms::bellmanFordTree(const Graph& graph, size_t source, vector<long long>& distance, vector<size_t>& parent)
     {
+        const AdjacencyIndex& edges = graph.getOutEdges();
         size_t numVertices = graph.getNumVertices();
+        size_t numWords = (numVertices + 63) / 64;
 
-        // The graph is trivially strongly connected
-        if (numVertices == 1) 
+        // A negative self-loop, or two neighbours whose edges have different weights with a negative sum, form a negative
+        // cycle (equal weights are an undirected edge, which is not a cycle)
+        auto closesShortCycle = [&edges](size_t vertex_u)
         {
-            return true;
+            for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+            {
+                size_t vertex_v = edges.targets[e];
+                if (vertex_v == vertex_u)
+                {
+                    if (edges.weights[e] < 0)
+                    {
+                        return true;
+                    }
+                    continue;
+                }
+                int reverse = edges.findWeight(vertex_v, vertex_u);
+                if (reverse != 0 && reverse != edges.weights[e] && static_cast<long long>(reverse) + edges.weights[e] < 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        distance.assign(numVertices, LLONG_MAX);
+        parent.assign(numVertices, SIZE_MAX);
+        vector<size_t> length(numVertices, 0);             // The number of edges of the walk that gave each distance
+        vector<uint64_t> current(numWords, 0);             // Vertices to scan in this pass
+        vector<uint64_t> next(numWords, 0);                // Vertices to scan in the next pass
+        distance[source] = 0;
+        current[source / 64] = 1ULL << (source % 64);
+        if (closesShortCycle(source))
+        {
+            return false;
         }
 
-        // Perform BFS from each vertex
-        for (size_t startVertex = 0; startVertex < numVertices; startVertex++) 
+        for (size_t pass = 1; pass <= numVertices; pass++)
         {
-            vector<bool> visited(numVertices, false);           // Initiate a vector to keep tracking the visited vertices
-            vector<size_t> parent(numVertices, INT_MAX);        // Create a dummy parent vector (added to make bfs function to be used for finding shortest path as well)
-            bfs(graph, startVertex, visited, parent, INT_MAX, false);  // INT_MAX and  "false" are dummy variables, from the reason mentioned above
-
-            // If any vertex was not visited, the graph is not strongly connected
-            for (size_t i = 0; i < numVertices; i++) 
+            // Scan the changed vertices in index order; a vertex after the current one changes in time for this pass
+            for (size_t word = 0; word < numWords; word++)
             {
-                if (!visited[i]) 
+                while (current[word] != 0)
                 {
-                    return false; 
+                    size_t vertex_u = word * 64 + static_cast<size_t>(__builtin_ctzll(current[word]));
+                    current[word] &= current[word] - 1;
+
+                    for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                    {
+                        size_t vertex_v = edges.targets[e];
+
+                        // v must not be the parent of u, so an undirected edge is not taken as a cycle
+                        if (distance[vertex_u] + edges.weights[e] >= distance[vertex_v] || parent[vertex_u] == vertex_v)
+                        {
+                            continue;
+                        }
+
+                        // Still relaxing on the V-th pass, or along a walk of V edges, means a negative cycle
+                        if (pass == numVertices || length[vertex_u] + 1 >= numVertices)
+                        {
+                            return false;
+                        }
+                        if (distance[vertex_v] == LLONG_MAX && closesShortCycle(vertex_v))
+                        {
+                            return false;
+                        }
+                        distance[vertex_v] = distance[vertex_u] + edges.weights[e];
+                        parent[vertex_v] = vertex_u;
+                        length[vertex_v] = length[vertex_u] + 1;
+                        vector<uint64_t>& pending = vertex_v > vertex_u ? current : next;
+                        pending[vertex_v / 64] |= 1ULL << (vertex_v % 64);
+                    }
                 }
             }
+
+            // Stop as soon as a pass changes nothing
+            if (find_if(next.begin(), next.end(), [](uint64_t bits) { return bits != 0; }) == next.end())
+            {
+                break;
+            }
+            current.swap(next);
         }
 
         return true;
     }
-
+    
 
     /**
-     * @brief This method finds the shortest path between two vertices in a given graph.
+     * @brief This auxiliary function finds the shortest path in a large graph with possible negative weights using a parallel Bellman-Ford.
      *
-     * @note: The method uses a strategy to choose the appropriate algorithm based on the properties of the graph (weighted/unweighted, containts negative edges or not).
-     * It uses BFS for unweighted graphs (time complexity: O(|V|+|E|)), Bellman-Ford for graphs with negative weights (time complexity: O(|V|*|E|)), 
-     * or Dijkstra's for non-negative weighted graphs (time complexity: O(|V|*|V|)), and thus does not waste resources.
+     * Each round, the vertices whose distance changed in the previous round are split between the threads, which relax
+     * their edges with an atomic minimum on the distances. If the distances still change in the V-th round, or if the
+     * parents (checked after rounds 16, 32, 64, ...) close a negative cycle, the graph contains a negative cycle. The path is
+     * the one with the fewest edges among the shortest paths, found by a BFS over the tight edges (so it does not depend on
+     * the number of threads). An undirected edge with a negative weight is not a cycle only because of the order in which the
+     * sequential search scans the edges, so such graphs are handed to bellmanFordShortestPath.
      *
      * @param graph The graph.
-     * @param start The start vertex.
-     * @param end The end vertex.
-     * @return A string representing the path or a message if the path doesn't exist.
+     * @param start The starting vertex.
+     * @param end The destination vertex.
+     * @param result Filled with the status, the distance and the path.
      */
-    string Algorithms::shortestPath(Graph& graph, size_t start, size_t end) 
+    void Algorithms::parallelBellmanFordShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result)
     {
+        const AdjacencyIndex& edges = graph.getOutEdges();
         size_t numVertices = graph.getNumVertices();
+        size_t maxWorkers = Parallel::getNumThreads();
 
-        // Error checking no. 1
-        if (start >= numVertices || end >= numVertices) 
+        // The same short cycles as in bellmanFordShortestPath; an undirected negative edge needs the sequential search
+        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
         {
-            return "Invalid start or end vertex";
+            for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+            {
+                size_t vertex_v = edges.targets[e];
+                int reverse = vertex_v != vertex_u ? edges.findWeight(vertex_v, vertex_u) : edges.weights[e];
+                if (reverse == 0 || static_cast<long long>(reverse) + edges.weights[e] >= 0)
+                {
+                    continue;
+                }
+                if (vertex_v != vertex_u && reverse == edges.weights[e])
+                {
+                    bellmanFordShortestPath(graph, start, end, result);
+                    return;
+                }
+                result.status = PathStatus::NegativeCycle;
+                return;
+            }
         }
 
-        // Error checking no. 2
-        if (start == end) 
+        vector<atomic<long long>> distance(numVertices);
+        vector<atomic<size_t>> parent(numVertices);
+        vector<atomic<bool>> queued(numVertices);           // Vertices already in the next frontier
+        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
         {
-            return "No path exists between a vertex and itself";
+            distance[vertex_u].store(LLONG_MAX, memory_order_relaxed);
+            parent[vertex_u].store(SIZE_MAX, memory_order_relaxed);
+            queued[vertex_u].store(false, memory_order_relaxed);
         }
+        distance[start].store(0, memory_order_relaxed);
 
-        // Extract sub-graph that contains both the start and end vertices
-        Graph subgraph;
-        extractSubgraph(graph, start, end, subgraph);
+        vector<vector<size_t>> reached(maxWorkers);         // The vertices each worker added to the next frontier
+        vector<size_t> frontier(1, start);
 
-        // Check if the graph is unweighted and has negative edges to choose the relevant algorithm to run
-        pair<bool, bool> graphType = checkGraphType(graph);
-        bool isUnweighted = graphType.first;
-        bool hasNegativeEdges = graphType.second;
+        for (size_t round = 1; !frontier.empty(); round++)
+        {
+            size_t numWorkers = max<size_t>(1, min(maxWorkers, frontier.size() / SSSP_GRAIN_VERTICES));
+            Parallel::run(numWorkers, [&](size_t worker)
+            {
+                size_t begin = frontier.size() * worker / numWorkers;
+                size_t finish = frontier.size() * (worker + 1) / numWorkers;
+                for (size_t i = begin; i < finish; i++)
+                {
+                    size_t vertex_u = frontier[i];
+                    long long distance_u = distance[vertex_u].load(memory_order_relaxed);
+                    for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                    {
+                        size_t vertex_v = edges.targets[e];
+                        if (relaxDistance(distance[vertex_v], distance_u + edges.weights[e]))
+                        {
+                            parent[vertex_v].store(vertex_u, memory_order_relaxed);
+                            if (!queued[vertex_v].exchange(true, memory_order_relaxed))
+                            {
+                                reached[worker].push_back(vertex_v);
+                            }
+                        }
+                    }
+                }
+            });
 
-        // Choose the algorithm based on the graph's type
-        if (isUnweighted) 
+            // The changed vertices form the next frontier
+            frontier.clear();
+            for (size_t worker = 0; worker < numWorkers; worker++)
+            {
+                frontier.insert(frontier.end(), reached[worker].begin(), reached[worker].end());
+                reached[worker].clear();
+            }
+            for (size_t i = 0; i < frontier.size(); i++)
+            {
+                queued[frontier[i]].store(false, memory_order_relaxed);
+            }
+
+            // Still changing after V rounds means a negative cycle; the parents usually show one much earlier
+            if (!frontier.empty() && (round >= numVertices || (round >= 16 && (round & (round - 1)) == 0 && hasNegativeParentCycle(edges, parent))))
+            {
+                result.status = PathStatus::NegativeCycle;
+                return;
+            }
+        }
+
+        // Check if the distance from start to end remains infinity
+        if (distance[end].load() == LLONG_MAX)
         {
-            return bfsShortestPath(subgraph, start, end);
-        } 
-        if (hasNegativeEdges) 
+            result.status = PathStatus::NoPath;
+            return;
+        }
+
+        // A BFS over the tight edges finds the shortest path with the fewest edges
+        vector<size_t> tightParent(numVertices, SIZE_MAX);
+        vector<size_t> pending(1, start);
+        tightParent[start] = start;
+        for (size_t i = 0; i < pending.size() && tightParent[end] == SIZE_MAX; i++)
         {
-            return bellmanFordShortestPath(subgraph, start, end);
-        } 
-        return dijkstraShortestPath(subgraph, start, end);        
+            size_t vertex_u = pending[i];
+            long long distance_u = distance[vertex_u].load(memory_order_relaxed);
+            for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+            {
+                size_t vertex_v = edges.targets[e];
+                if (tightParent[vertex_v] == SIZE_MAX && distance_u + edges.weights[e] == distance[vertex_v].load(memory_order_relaxed))
+                {
+                    tightParent[vertex_v] = vertex_u;
+                    pending.push_back(vertex_v);
+                }
+            }
+        }
+
+        // Build the shortest path
+        result.status = PathStatus::Found;
+        result.distance = distance[end].load();
+        buildPath(start, end, tightParent, result.path);
     }
 
-     /**
-     * @brief This method checks if there is a cycle in the graph.
-     *
-     * This method uses DFS to find a back edge, which indicates a cycle.
+
+    /**
+     * @brief This auxiliary function finds the shortest path between two vertices using Dijkstra's algorithm.
+     * 
+     * Dijkstra's algorithm is used for finding the shortest path from a single source vertex
+     * to a single destination vertex in a graph with non-negative edge weights.
      *
-     * @param graph The graph to check.
-     * @return A string representing the cycle if one exists; otherwise, "0".
+     * @param graph The graph.
+     * @param start The index of the start vertex.
+     * @param end The index of the end vertex.
+     * @param result Filled with the status, the distance and the path.
      */
-    string Algorithms::isContainsCycle(Graph& graph) 
+    void Algorithms::dijkstraShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result) 
     {
-        size_t numVertices = graph.getNumVertices();        // A variable to store the number of vertices in the graph
-        vector<bool> visited(numVertices, false);           // A vector to track if each vertex visited
-        vector<bool> recStack(numVertices, false);          // A vector to track if a vertex is currently in the recursion (used by dfs_cycle)
-        vector<size_t> parent(numVertices, 0);              // A vector to track the parent of each vertex, used to build the cycle (if exists)
+        size_t numVertices = graph.getNumVertices();    // A variable to store the number of vertices in the graph
+        vector<int> distance(numVertices, INT_MAX);     // Initialize distance vector to infinity
+        vector<int> key(numVertices, INT_MAX);          // The distances of the unvisited vertices (INT_MAX once a vertex is visited)
+        vector<size_t> parent(numVertices, SIZE_MAX);   // Initialize parent vector for path building
 
-        // Iterate over all unvisited vertices by DFS 
-        for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++) 
+        // A sparsely stored graph has no matrix rows, so each row is spread into a scratch row when it is needed
+        const AdjacencyIndex* edges = nullptr;
+        vector<int> scratchRow;
+        if (graph.getDenseRow(0) == nullptr) 
+        {
+            edges = &graph.getOutEdges();
+            scratchRow.assign(numVertices, 0);
+        }
+
+        distance[start] = 0;
+        key[start] = 0;
+
+        // Find the unvisited vertex with the smallest distance
+        for (size_t i = 0; i < numVertices; i++) 
         {
-            if (!visited[vertex_v]) 
+            size_t minVertex = findMinDistanceVertex(key);
+
+            // If no vertex is found break from the loop, since the start is not connected to any vertex
+            if (minVertex == SIZE_MAX) 
             {
-                string cycle = dfs_cycle(graph, vertex_v, visited, recStack, parent, graph.isGraphDirected());
-                
-                // If a cyrcle found, return it
-                if (!cycle.empty()) 
-                {
-                    return cycle;
-                 }
+                break;
+            }
+
+            key[minVertex] = INT_MAX;       // Mark the currect vertex as visited
+
+            // The distance to end is final
+            if (minVertex == end) 
+            {
+                break;
+            }
+
+            if (edges == nullptr) 
+            {
+                relaxDenseRow(graph.getDenseRow(minVertex), minVertex, distance, key, parent);
+                continue;
+            }
+            for (size_t e = edges->offsets[minVertex]; e < edges->offsets[minVertex + 1]; e++) 
+            {
+                scratchRow[edges->targets[e]] = edges->weights[e];
+            }
+            relaxDenseRow(scratchRow.data(), minVertex, distance, key, parent);
+            for (size_t e = edges->offsets[minVertex]; e < edges->offsets[minVertex + 1]; e++) 
+            {
+                scratchRow[edges->targets[e]] = 0;
             }
         }
 
-        // If a cyrcle wasn't found, return "0"
-        return "0"; 
+        // Check if the end point is reachable
+        if (distance[end] == INT_MAX) 
+        {
+            result.status = PathStatus::NoPath;
+            return;
+        }
+
+        // Build the shortest path
+        result.status = PathStatus::Found;
+        result.distance = distance[end];
+        buildPath(start, end, parent, result.path);
     }
-    
+
 
     /**
-     * @brief This function checks if a graph is bipartite.
+     * @brief This auxiliary function finds the shortest path between two vertices using a bidirectional Dijkstra's algorithm.
      *
-     * @note A graph is bipartite if it can be colored using two colors such that no two adjacent vertices with the same color.
-     * This function uses DFS to color the graph.
+     * A forward search from start (over the out-edges) and a backward search from end (over the in-edges) each keep a
+     * lazy-deletion binary heap, and the side with the smaller key is advanced. The search stops once the two smallest
+     * keys add up to more than the shortest path seen so far, so every vertex on a shortest path is settled by at least
+     * one side. The path is rebuilt by buildBidirectionalPath.
      *
-     * @param graph The graph to check.
-     * @return A string indicating if the graph is bipartite; otherwise, an error message.
+     * @param graph The graph (with positive weights only).
+     * @param start The index of the start vertex.
+     * @param end The index of the end vertex.
+     * @param result Filled with the status, the distance and the path.
      */
-    string Algorithms::isBipartite(Graph& graph) 
+    void Algorithms::bidirectionalDijkstraShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result)
     {
-        size_t numVertices = graph.getNumVertices();
-        vector<int> color(numVertices, -1);             // Initiate a vector with a length of the number of vertices and uncolor (-1) all of them
+        typedef priority_queue<pair<long long, size_t>, vector<pair<long long, size_t>>, greater<pair<long long, size_t>>> Heap;
 
-        for (size_t i = 0; i < numVertices; ++i) 
+        const AdjacencyIndex& outEdges = graph.getOutEdges();
+        const AdjacencyIndex& inEdges = graph.getInEdges();
+        size_t numVertices = graph.getNumVertices();
+        vector<long long> forward(numVertices, LLONG_MAX);      // The tentative distance of every vertex from start
+        vector<long long> backward(numVertices, LLONG_MAX);     // The tentative distance of every vertex to end
+        vector<char> forwardSettled(numVertices, 0);
+        vector<char> backwardSettled(numVertices, 0);
+        vector<size_t> forwardReached(1, start);                // The vertices with a forward distance
+        vector<size_t> backwardReached(1, end);                 // The vertices with a backward distance
+        Heap forwardHeap;
+        Heap backwardHeap;
+        long long best = LLONG_MAX;                             // The length of the shortest path seen so far
+
+        forward[start] = 0;
+        backward[end] = 0;
+        forwardHeap.push(make_pair(0LL, start));
+        backwardHeap.push(make_pair(0LL, end));
+
+        while (true) 
         {
-            // If a vertex is uncolored, start a new DFS
-            if (color[i] == -1) 
-            {  
-                if (!dfsCheck(graph, i, color, 0)) 
+            // Drop stale entries of vertices that were already settled
+            while (!forwardHeap.empty() && forwardSettled[forwardHeap.top().second]) 
+            {
+                forwardHeap.pop();
+            }
+            while (!backwardHeap.empty() && backwardSettled[backwardHeap.top().second]) 
+            {
+                backwardHeap.pop();
+            }
+
+            // A side that ran out settled everything it can reach; otherwise stop once no shorter path can be found
+            if (forwardHeap.empty() || backwardHeap.empty()) 
+            {
+                break;
+            }
+            if (best != LLONG_MAX && forwardHeap.top().first + backwardHeap.top().first > best) 
+            {
+                break;
+            }
+
+            bool isForward = forwardHeap.top().first <= backwardHeap.top().first;
+            const AdjacencyIndex& edges = isForward ? outEdges : inEdges;
+            vector<long long>& own = isForward ? forward : backward;
+            const vector<long long>& other = isForward ? backward : forward;
+            vector<char>& settled = isForward ? forwardSettled : backwardSettled;
+            vector<size_t>& reached = isForward ? forwardReached : backwardReached;
+            Heap& heap = isForward ? forwardHeap : backwardHeap;
+
+            size_t vertex_u = heap.top().second;
+            heap.pop();
+            settled[vertex_u] = 1;
+
+            for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++) 
+            {
+                size_t vertex_v = edges.targets[e];
+                long long candidate = own[vertex_u] + edges.weights[e];
+                if (other[vertex_v] != LLONG_MAX) 
+                {
+                    best = min(best, candidate + other[vertex_v]);
+                }
+                if (!settled[vertex_v] && candidate < own[vertex_v]) 
                 {
-                    return "The graph is not bipartite";
+                    if (own[vertex_v] == LLONG_MAX) 
+                    {
+                        reached.push_back(vertex_v);
+                    }
+                    own[vertex_v] = candidate;
+                    heap.push(make_pair(candidate, vertex_v));
                 }
             }
         }
 
-        // Saperate the vertices based on their colors to two sets
-        vector<size_t> setA;
-        vector<size_t> setB;
+        if (best == LLONG_MAX) 
+        {
+            result.status = PathStatus::NoPath;
+            return;
+        }
 
-        for (size_t i = 0; i < numVertices; i++) 
+        // Keep only the exact distances of the settled vertices
+        vector<size_t> settledForward;
+        for (size_t i = 0; i < forwardReached.size(); i++) 
         {
-            if (color[i] == 0) 
+            if (forwardSettled[forwardReached[i]]) 
             {
-                setA.push_back(i);
+                settledForward.push_back(forwardReached[i]);
             }
-            else
+            else 
             {
-                setB.push_back(i);
+                forward[forwardReached[i]] = LLONG_MAX;
             }
         }
-        
-        // Present the results as string
-        string result = "The graph is bipartite: A=" + buildSet(setA) + ", B=" + buildSet(setB);
-        return result;
+        for (size_t i = 0; i < backwardReached.size(); i++) 
+        {
+            if (!backwardSettled[backwardReached[i]]) 
+            {
+                backward[backwardReached[i]] = LLONG_MAX;
+            }
+        }
+
+        // Build the shortest path
+        result.status = PathStatus::Found;
+        result.distance = best;
+        buildBidirectionalPath(graph, start, end, best, forward, backward, settledForward, result.path);
     }
 
 
     /**
-     * @brief This method checks for a negative cycle in the graph.
+     * @brief This auxiliary function finds the shortest path between two vertices using Dial's algorithm (a bucket queue).
      *
-     * This method checks for negative cycles using a variant of the Bellman-Ford algorithm, which is capable of detecting such cycles.
+     * Vertices wait in a circular array of maxWeight + 1 buckets indexed by distance. Since every weight is between 1 and
+     * maxWeight, the bucket of the current distance is complete when it is reached; it is sorted so that vertices with
+     * equal distances are settled by index, as in the other Dijkstra versions. Time complexity: O(|E| + |V|*maxWeight).
      *
-     * @param graph The graph to check.
-     * @return A string represents a negative cycle if exists; otherwise, "No negative cycle exists".
+     * @param graph The graph (with positive weights only).
+     * @param start The index of the start vertex.
+     * @param end The index of the end vertex.
+     * @param maxWeight The largest edge weight of the graph.
+     * @param result Filled with the status, the distance and the path.
      */
-    string Algorithms::negativeCycle(Graph& graph)
+    void Algorithms::dialShortestPath(const Graph& graph, size_t start, size_t end, int maxWeight, PathResult& result)
     {
-        size_t numVertices = graph.getNumVertices();        // A variable to store the number of vertices in t he graph   
-        vector<int> distance(numVertices, 0);               // Initialize distance vector with zeros
-        vector<size_t> parent(numVertices, INT_MAX);        // Initialize parent vector with INT_MAX. This vector will use us to build paths and detect cycles
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        size_t numVertices = graph.getNumVertices();
+        size_t numBuckets = static_cast<size_t>(maxWeight) + 1;
+        vector<long long> distance(numVertices, LLONG_MAX);     // Initialize distance vector to infinity
+        vector<size_t> parent(numVertices, SIZE_MAX);           // Initialize parent vector for path building
+        vector<char> settled(numVertices, 0);                   // Vertices whose distance is final
+        vector<vector<size_t>> buckets(numBuckets);             // Bucket d % numBuckets holds the vertices reached with distance d
+        vector<size_t> batch;
+        size_t pending = 1;                                     // The number of entries in all buckets (including stale ones)
 
-        // Part 1: Check for negative self-loops
-        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++) 
-        {
-            if (graph.getAdjacencyMatrix()[vertex_u][vertex_u] < 0) 
-            {
-                return to_string(vertex_u) + "->" + to_string(vertex_u);
-            }
-        }
+        distance[start] = 0;
+        buckets[0].push_back(start);
 
-        // Part 2: Check for negative cycles between neighboring vertices with different edge weights
-        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++) 
+        for (long long current = 0; pending > 0; current++) 
         {
-            for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++) 
+            // No new vertex can join the current bucket, since every weight is between 1 and maxWeight
+            batch.clear();
+            batch.swap(buckets[static_cast<size_t>(current) % numBuckets]);
+            pending -= batch.size();
+            sort(batch.begin(), batch.end());
+
+            for (size_t i = 0; i < batch.size(); i++) 
             {
-                // Check if there are differing weights in the edges u->v and v->u that sum to a negative value
-                if (vertex_u != vertex_v && graph.getAdjacencyMatrix()[vertex_u][vertex_v] != 0 && graph.getAdjacencyMatrix()[vertex_v][vertex_u] != 0 &&
-                    graph.getAdjacencyMatrix()[vertex_u][vertex_v] != graph.getAdjacencyMatrix()[vertex_v][vertex_u]) 
-                    {
-                    
-                    int weight = graph.getAdjacencyMatrix()[vertex_u][vertex_v] + graph.getAdjacencyMatrix()[vertex_v][vertex_u];
-                    if (weight < 0) 
+                size_t vertex_u = batch[i];
+
+                // Skip stale entries of vertices that were already settled or improved
+                if (settled[vertex_u] || distance[vertex_u] != current) 
+                {
+                    continue;
+                }
+                settled[vertex_u] = 1;
+
+                // The distance to end is final
+                if (vertex_u == end) 
+                {
+                    pending = 0;
+                    break;
+                }
+
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++) 
+                {
+                    size_t vertex_v = edges.targets[e];
+                    long long candidate = current + edges.weights[e];
+                    if (!settled[vertex_v] && candidate < distance[vertex_v]) 
                     {
-                        return to_string(vertex_u) + "->" + to_string(vertex_v) + "->" + to_string(vertex_u);
+                        distance[vertex_v] = candidate;
+                        parent[vertex_v] = vertex_u;
+                        buckets[static_cast<size_t>(candidate) % numBuckets].push_back(vertex_v);
+                        pending++;
                     }
                 }
             }
         }
 
-        // Part 3: Check for negative cycles with with path involves more than one edge
-        string result = findNegativeCircle(graph);
-        if (result != "No negative cycle exists") 
+        // Check if the end point is reachable
+        if (distance[end] == LLONG_MAX) 
         {
-            return result;
+            result.status = PathStatus::NoPath;
+            return;
         }
 
-        return "No negative cycle exists";
+        // Build the shortest path
+        result.status = PathStatus::Found;
+        result.distance = distance[end];
+        buildPath(start, end, parent, result.path);
     }
 
 
-
-    /*********************************************/
-    ///             PRIVATE SECTION             ///
-    /*********************************************/
-
     /**
-     * @brief This auxiliary function performs BFS on the graph starting from the given vertex.
-     * It can also be used to find the shortest path by tracking the parent of each vertex.
+     * @brief This auxiliary function finds the shortest path between two vertices using Dijkstra's algorithm with a radix heap.
      *
-     * @param graph The graph to perform BFS on.
-     * @param startVertex The starting vertex for BFS.
-     * @param visited A vector to track visited vertices.
-     * @param parent A vector to track the parent of the vertices (extents the classic BFS for finding the shortest path).
-     * @param parent A vector to track the parent of each vertex, used for rebuilding paths (extents the classic BFS for finding the shortest path).
+     * A key waits in the bucket of the highest bit in which it differs from the last extracted key, so every key moves
+     * down at most 64 times. All keys equal to the last extracted key are settled together, sorted by index, as in the
+     * other Dijkstra versions. Time complexity: O(|E| + |V|*log(C)) where C is the largest weight.
+     *
+     * @param graph The graph (with positive weights only).
+     * @param start The index of the start vertex.
+     * @param end The index of the end vertex.
+     * @param result Filled with the status, the distance and the path.
      */
-    void Algorithms::bfs(Graph& graph, size_t startVertex, vector<bool>& visited, vector<size_t>& parent, size_t end, bool reverse = false) 
+    void Algorithms::radixHeapShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result)
     {
-        queue<size_t> queue;                    // Initiate queue to track the vertices in the graph
-        visited[startVertex] = true;            // Mark the startVertex as visited
-        queue.push(startVertex);                // Add the startVertex to the queue 
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        size_t numVertices = graph.getNumVertices();
+        vector<long long> distance(numVertices, LLONG_MAX);     // Initialize distance vector to infinity
+        vector<size_t> parent(numVertices, SIZE_MAX);           // Initialize parent vector for path building
+        vector<char> settled(numVertices, 0);                   // Vertices whose distance is final
+        vector<vector<pair<uint64_t, size_t>>> buckets(65);     // Bucket 0 holds keys equal to last, bucket b keys whose highest differing bit is b - 1
+        vector<pair<uint64_t, size_t>> batch;
+        uint64_t last = 0;                                      // The last extracted key (keys never go below it)
+        size_t pending = 1;                                     // The number of entries in all buckets (including stale ones)
 
+        distance[start] = 0;
+        buckets[0].push_back(make_pair(uint64_t(0), start));
 
-        // According to the BFS algorithm we will continue the process until there are no more vertices to explore
-        while (!queue.empty()) 
+        while (pending > 0) 
         {
-            size_t currentVertex = queue.front();       // Store the front vertex and remove it from the queue
-            queue.pop();
-
-            // NOTE: This condition is only used for bfsShortestPath
-            if (currentVertex == end) 
+            // Refill bucket 0 from the first non-empty bucket: its minimum becomes the new last key
+            if (buckets[0].empty()) 
             {
-                break;
+                size_t b = 1;
+                while (buckets[b].empty()) 
+                {
+                    b++;
+                }
+                last = UINT64_MAX;
+                for (size_t i = 0; i < buckets[b].size(); i++) 
+                {
+                    last = min(last, buckets[b][i].first);
+                }
+                for (size_t i = 0; i < buckets[b].size(); i++) 
+                {
+                    uint64_t key = buckets[b][i].first;
+                    size_t target = key == last ? 0 : static_cast<size_t>(64 - __builtin_clzll(key ^ last));
+                    buckets[target].push_back(buckets[b][i]);
+                }
+                buckets[b].clear();
             }
 
-            size_t numVertices = graph.getNumVertices();
-            for (size_t i = 0; i < numVertices; i++)           // Iterate over all vertices in the graph to find all neighbors vertices
+            // All the keys equal to last are known, since every weight is at least 1
+            batch.clear();
+            batch.swap(buckets[0]);
+            pending -= batch.size();
+            sort(batch.begin(), batch.end());
+
+            for (size_t i = 0; i < batch.size(); i++) 
             {
+                size_t vertex_u = batch[i].second;
+
+                // Skip stale entries of vertices that were already settled or improved
+                if (settled[vertex_u] || static_cast<uint64_t>(distance[vertex_u]) != last) 
+                {
+                    continue;
+                }
+                settled[vertex_u] = 1;
 
-                // NOTE: This variables is more relevant for the shortest path's (to extract the sub-graph)
-                // In other cases, reverse is equal to "false" defaultly
-                size_t neighbour = reverse ? i : currentVertex;
-                size_t target = reverse ? currentVertex : i;
+                // The distance to end is final
+                if (vertex_u == end) 
+                {
+                    pending = 0;
+                    break;
+                }
 
-                // Check if there is an edge from currentVertex to vertex i, and it is still "true" (not visited yet)
-                if(graph.getAdjacencyMatrix()[neighbour][target] != 0 && !visited[i]) 
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++) 
                 {
-                    visited[i] = true;
-                    parent[i] = currentVertex;
-                    queue.push(i);
+                    size_t vertex_v = edges.targets[e];
+                    long long candidate = distance[vertex_u] + edges.weights[e];
+                    if (!settled[vertex_v] && candidate < distance[vertex_v]) 
+                    {
+                        distance[vertex_v] = candidate;
+                        parent[vertex_v] = vertex_u;
+                        uint64_t key = static_cast<uint64_t>(candidate);
+                        buckets[static_cast<size_t>(64 - __builtin_clzll(key ^ last))].push_back(make_pair(key, vertex_v));
+                        pending++;
+                    }
                 }
             }
         }
+
+        // Check if the end point is reachable
+        if (distance[end] == LLONG_MAX) 
+        {
+            result.status = PathStatus::NoPath;
+            return;
+        }
+
+        // Build the shortest path
+        result.status = PathStatus::Found;
+        result.distance = distance[end];
+        buildPath(start, end, parent, result.path);
     }
 
+
     /**
-     * @brief This auxiliary function extracts a subgraph from the given graph, 
-     * containing only nodes and edges that form possible paths from the start to the end vertex.
+     * @brief This auxiliary function finds the shortest path between two vertices using A* steered by an ALT landmark index.
      *
-     * The function uses two breadth-first searches (BFS):
-     * 1. A forward BFS from the start vertex to identify all nodes reachable from the start.
-     * 2. A reverse BFS from the end vertex to identify all nodes that can lead to the end.
-     * The intersection of these nodes create the set of relevant nodes in the subgraph.
+     * The keys of the lazy-deletion binary heap are the distance from start plus the landmark lower bound on the distance
+     * to end. The bound is consistent, so every vertex is settled once with its exact distance. The search goes on until
+     * the smallest key exceeds the distance to end, so that every vertex on a shortest path is settled, and the path is
+     * rebuilt by buildBidirectionalPath (the same path as a forward Dijkstra's search).
      *
-     * @param graph The original graph from which the subgraph is to be extracted.
-     * @param start The starting vertex for potential paths.
-     * @param end The ending vertex for potential paths.
-     * @param subgraph A Graph object that will be populated with the resulting subgraph.
+     * @param graph The graph (with positive weights only).
+     * @param start The index of the start vertex.
+     * @param end The index of the end vertex.
+     * @param landmarks The landmark index of the graph.
+     * @param result Filled with the status, the distance and the path.
      */
-    void Algorithms::extractSubgraph(Graph& graph, size_t start, size_t end, Graph& subgraph) 
+    void Algorithms::landmarkShortestPath(const Graph& graph, size_t start, size_t end, const LandmarkIndex& landmarks, PathResult& result)
     {
-        size_t numVertices = graph.getNumVertices();            // A variable to store the number of vertices in the original graph
-        vector<bool> reachableFromStart(numVertices, false);    // A vector to track which nodes are reachable from the start vertex
-        vector<bool> leadsToEnd(numVertices, false);            // A vector to tracks which nodes can lead to the end vertex
-        vector<size_t> parent(numVertices, SIZE_MAX);           // Dummy parent vector for BFS, not used here but necessary for the bfs function signature
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        size_t numVertices = graph.getNumVertices();
+        vector<long long> distance(numVertices, LLONG_MAX);     // The tentative distance of every vertex from start
+        vector<char> settled(numVertices, 0);                   // Vertices whose distance is final
+        vector<size_t> reached(1, start);                       // The vertices with a tentative distance
+        priority_queue<pair<long long, size_t>, vector<pair<long long, size_t>>, greater<pair<long long, size_t>>> heap;
 
+        distance[start] = 0;
+        heap.push(make_pair(landmarks.lowerBound(start, end), start));
 
-        bfs(graph, start, reachableFromStart, parent, SIZE_MAX, false);     // BFS from the start vertex to find all reachable nodes
-        bfs(graph, end, leadsToEnd, parent, SIZE_MAX, true);                // Reverse BFS from the end vertex on the reverse graph to find all nodes leading to the end
+        // Once end is settled, keep going while keys can still belong to vertices on a shortest path
+        while (!heap.empty() && (!settled[end] || heap.top().first <= distance[end])) 
+        {
+            size_t vertex_u = heap.top().second;
+            heap.pop();
 
+            // Skip stale entries of vertices that were already settled
+            if (settled[vertex_u]) 
+            {
+                continue;
+            }
+            settled[vertex_u] = 1;
 
-        // Build the subgraph based on nodes that are both reachable from start and can lead to end
-        vector<vector<int>> subgraphMat(numVertices, vector<int>(numVertices, 0));
-        for (size_t i = 0; i < numVertices; i++) 
-        {
-            if (reachableFromStart[i] && leadsToEnd[i]) 
+            for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++) 
             {
-                for (size_t j = 0; j < numVertices; j++) 
+                size_t vertex_v = edges.targets[e];
+                long long candidate = distance[vertex_u] + edges.weights[e];
+                if (!settled[vertex_v] && candidate < distance[vertex_v]) 
                 {
-                    if (reachableFromStart[j] && leadsToEnd[j] && graph.getAdjacencyMatrix()[i][j] != 0) 
+                    if (distance[vertex_v] == LLONG_MAX) 
                     {
-                        subgraphMat[i][j] = graph.getAdjacencyMatrix()[i][j];       // Include the edge in the subgraph if it connects nodes in the subgraph
+                        reached.push_back(vertex_v);
                     }
+                    distance[vertex_v] = candidate;
+                    heap.push(make_pair(candidate + landmarks.lowerBound(vertex_v, end), vertex_v));
                 }
             }
         }
-        
-        // Load the resulted matrix into the subgraph Graph that pass to the function as reference
-        subgraph.loadGraph(subgraphMat);
-    }
-
-
-    /**
-     * @brief This auxiliary function finds the shortest path using BFS for unweighted graphs.
-     *
-     * This function returns the shortest path by building the path itself.
-     *
-     * @param graph The graph.
-     * @param start The start vertex.
-     * @param end The end vertex.
-     * @return A string representing the shortest path.
-     */
-    string Algorithms::bfsShortestPath(Graph& graph, size_t start, size_t end) 
-    {
-        size_t numVertices = graph.getNumVertices();
-        vector<bool> visited(numVertices, false);
-        vector<size_t> parent(numVertices, INT_MAX);
 
-        bfs(graph, start, visited, parent, end);
+        // Check if the end point is reachable
+        if (!settled[end]) 
+        {
+            result.status = PathStatus::NoPath;
+            return;
+        }
 
-        if (!visited[end]) 
+        // Keep only the exact distances of the settled vertices; the backward side is end alone
+        vector<size_t> settledVertices;
+        for (size_t i = 0; i < reached.size(); i++) 
         {
-            return "No path exists between " + to_string(start) + " and " + to_string(end);
+            if (settled[reached[i]]) 
+            {
+                settledVertices.push_back(reached[i]);
+            }
+            else 
+            {
+                distance[reached[i]] = LLONG_MAX;
+            }
         }
+        vector<long long> toEnd(numVertices, LLONG_MAX);
+        toEnd[end] = 0;
 
         // Build the shortest path
-        string path = buildPath(start, end, parent);
-
-        return path;
+        result.status = PathStatus::Found;
+        result.distance = distance[end];
+        buildBidirectionalPath(graph, start, end, distance[end], distance, toEnd, settledVertices, result.path);
     }
 
 
     /**
-     * @brief This auxiliary function finds the shortest path in a graph with possible negative weights using Bellman-Ford algorithm.
+     * @brief This auxiliary function finds the shortest path between two vertices using a parallel delta-stepping search.
      *
-     * This algorithm also checks for negative cycles and if detected, returns an error message.
+     * The search stops once the buckets left start after the distance to end (see deltaSteppingDistances), and the path is
+     * rebuilt by buildBidirectionalPath (the same path as a forward Dijkstra's search).
      *
-     * @param graph The graph.
-     * @param start The starting vertex.
-     * @param end The destination vertex.
-     * @return A string representing the path or an error message if a negative cycle is detected.
+     * @param graph The graph (with positive weights only).
+     * @param start The index of the start vertex.
+     * @param end The index of the end vertex.
+     * @param result Filled with the status, the distance and the path.
      */
-    string Algorithms::bellmanFordShortestPath(Graph& graph, size_t start, size_t end)
+    void Algorithms::deltaSteppingShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result)
     {
         size_t numVertices = graph.getNumVertices();
-        vector<int> distance(numVertices, INT_MAX);
-        vector<size_t> parent(numVertices, INT_MAX);
-        distance[start] = 0;
+        vector<long long> distance;
+        long long exactBelow = deltaSteppingDistances(graph, start, end, distance);
 
-        // Relax edges V-1 times
-        for (int i = 0; i < numVertices - 1; i++)
-        {
-            relaxEdges(graph, distance, parent);
-        }
-
-        // Check for negative cycle on the V-th iteration
-        if (relaxEdges(graph, distance, parent))
+        // Check if the end point is reachable
+        if (distance[end] == LLONG_MAX)
         {
-            return "Graph contains a negative cycle";
+            result.status = PathStatus::NoPath;
+            return;
         }
 
-        // Check if the distance from start to end remains infinity
-        if (distance[end] == INT_MAX)
+        // Keep only the final distances; the backward side is end alone
+        vector<long long> forward(numVertices, LLONG_MAX);
+        vector<size_t> settledVertices;
+        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
         {
-            return "No path exists between " + to_string(start) + " and " + to_string(end);
+            if (distance[vertex_u] < exactBelow)
+            {
+                forward[vertex_u] = distance[vertex_u];
+                settledVertices.push_back(vertex_u);
+            }
         }
+        vector<long long> toEnd(numVertices, LLONG_MAX);
+        toEnd[end] = 0;
 
         // Build the shortest path
-        string path = buildPath(start, end, parent);
-        return path;
+        result.status = PathStatus::Found;
+        result.distance = forward[end];
+        buildBidirectionalPath(graph, start, end, forward[end], forward, toEnd, settledVertices, result.path);
     }
-    
+
 
     /**
-     * @brief This auxiliary function relaxes the edges in the graph during the shortest path process.
+     * @brief This auxiliary function computes the distances from a vertex using a parallel delta-stepping search.
      *
-     * @param graph The graph on which the edges are relaxed.
-     * @param distance The vector storing the distances from the source vertex to each vertex.
-     * @param parent The vector storing the parent of each vertex in the shortest path tree.
+     * The tentative distances are kept in buckets of width delta (the largest weight over the average degree). The vertices of
+     * the first non-empty bucket are split between the threads, which relax all their edges with an atomic minimum on the
+     * distances and put the improved vertices in their own buckets; a bucket is scanned again until no edge refills it. The
+     * search stops once the buckets left start after the distance to end, or once they are all empty.
+     *
+     * @param graph The graph (with positive weights only).
+     * @param start The index of the start vertex.
+     * @param end The index of the end vertex (pass a value >= the number of vertices to search the whole graph).
+     * @param distance Filled with the tentative distance of every vertex (LLONG_MAX for vertices that were not reached).
+     * @return The bound below which the distances are final (LLONG_MAX if the whole graph was searched).
      */
-    bool Algorithms::relaxEdges(Graph& graph, vector<int>& distance, vector<size_t>& parent)
+    long long Algorithms::deltaSteppingDistances(const Graph& graph, size_t start, size_t end, vector<long long>& distance)
     {
-        bool hasNegativeCycle = false;
+        const AdjacencyIndex& edges = graph.getOutEdges();
         size_t numVertices = graph.getNumVertices();
+        size_t maxWorkers = Parallel::getNumThreads();
+        long long averageDegree = static_cast<long long>(max<size_t>(1, edges.numEntries() / max<size_t>(1, numVertices)));
+        long long delta = max(1LL, graph.getMaxWeight() / averageDegree);
 
+        vector<atomic<long long>> tentative(numVertices);
         for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
         {
-            for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++)
+            tentative[vertex_u].store(LLONG_MAX, memory_order_relaxed);
+        }
+        tentative[start].store(0, memory_order_relaxed);
+
+        vector<vector<vector<size_t>>> buckets(maxWorkers);     // The buckets of every worker, by index
+        vector<size_t> frontier(1, start);
+        size_t bucket = 0;
+        long long exactBelow = LLONG_MAX;                       // The distances below this bound are final
+
+        while (true)
+        {
+            size_t numWorkers = max<size_t>(1, min(maxWorkers, frontier.size() / SSSP_GRAIN_VERTICES));
+            Parallel::run(numWorkers, [&](size_t worker)
             {
-                int weight = graph.getAdjacencyMatrix()[vertex_u][vertex_v];
-                
-                // Check if there is a negative cycle between two neighboring vertices (and the edge is directed)
-                if (vertex_u != vertex_v && graph.getAdjacencyMatrix()[vertex_u][vertex_v] != 0 && graph.getAdjacencyMatrix()[vertex_v][vertex_u] != 0 &&
-                    graph.getAdjacencyMatrix()[vertex_u][vertex_v] != graph.getAdjacencyMatrix()[vertex_v][vertex_u])
+                vector<vector<size_t>>& local = buckets[worker];
+                size_t begin = frontier.size() * worker / numWorkers;
+                size_t finish = frontier.size() * (worker + 1) / numWorkers;
+                for (size_t i = begin; i < finish; i++)
                 {
-                    int weightSum = graph.getAdjacencyMatrix()[vertex_u][vertex_v] + graph.getAdjacencyMatrix()[vertex_v][vertex_u];
-                    if (weightSum < 0)
+                    size_t vertex_u = frontier[i];
+                    long long distance_u = tentative[vertex_u].load(memory_order_relaxed);
+
+                    // Skip vertices that moved to an earlier bucket since (they were scanned there)
+                    if (static_cast<size_t>(distance_u / delta) < bucket)
                     {
-                        // Negative cycle found between two neighboring vertices, continue the loop
-                        hasNegativeCycle = true;
                         continue;
                     }
+                    for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                    {
+                        size_t vertex_v = edges.targets[e];
+                        long long candidate = distance_u + edges.weights[e];
+                        if (relaxDistance(tentative[vertex_v], candidate))
+                        {
+                            size_t index = static_cast<size_t>(candidate / delta);
+                            if (local.size() <= index)
+                            {
+                                local.resize(index + 1);
+                            }
+                            local[index].push_back(vertex_v);
+                        }
+                    }
+                }
+            });
+
+            // Find the first non-empty bucket (the same one again if it was refilled)
+            size_t next = SIZE_MAX;
+            for (size_t worker = 0; worker < maxWorkers; worker++)
+            {
+                for (size_t index = bucket; index < buckets[worker].size() && index < next; index++)
+                {
+                    if (!buckets[worker][index].empty())
+                    {
+                        next = index;
+                        break;
+                    }
                 }
-                
-                // Check if there is an edge u->v and if the current path through u is shorter
-                if (canRelax(graph, vertex_u, vertex_v, weight, distance, parent))
+            }
+
+            // Every vertex on a shortest path to end is in an earlier bucket, so its distance is final
+            if (next == SIZE_MAX)
+            {
+                break;
+            }
+            long long distanceToEnd = end < numVertices ? tentative[end].load(memory_order_relaxed) : LLONG_MAX;
+            if (distanceToEnd != LLONG_MAX && static_cast<long long>(next) > distanceToEnd / delta)
+            {
+                exactBelow = static_cast<long long>(next) * delta;
+                break;
+            }
+
+            bucket = next;
+            frontier.clear();
+            for (size_t worker = 0; worker < maxWorkers; worker++)
+            {
+                if (bucket < buckets[worker].size())
                 {
-                    distance[vertex_v] = distance[vertex_u] + weight;   // Update the distance to vertex v through u
-                    parent[vertex_v] = vertex_u;                        // Record u as the parent of v
-                    hasNegativeCycle = true;                            // Mark that a negative cycle is detected
+                    frontier.insert(frontier.end(), buckets[worker][bucket].begin(), buckets[worker][bucket].end());
+                    buckets[worker][bucket].clear();
                 }
             }
         }
-        return hasNegativeCycle;
+
+        // Hand the distances to the caller
+        distance.resize(numVertices);
+        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+        {
+            distance[vertex_u] = tentative[vertex_u].load(memory_order_relaxed);
+        }
+        return exactBelow;
     }
 
+
     /**
-     * @brief This auxiliary function checks if an edge can be relaxed.
+     * @brief This auxiliary function finds the shortest path between two vertices with the contraction hierarchy of the graph.
      *
-     * @param graph The graph containing the edge.
-     * @param vertex_u The source vertex of the edge.
-     * @param vertex_v The destination vertex of the edge.
-     * @param weight The weight of the edge.
-     * @param distance The vector storing the distances from the source vertex to each vertex.
-     * @param parent The vector storing the parent of each vertex in the shortest path tree.
-     * @return true if the edge can be relaxed, false otherwise.
+     * The distance is found by a bidirectional upward search, and the path is the one a forward Dijkstra's search returns
+     * (see ContractionHierarchy::path).
+     *
+     * @param graph The graph (with non-negative weights only).
+     * @param start The index of the start vertex.
+     * @param end The index of the end vertex.
+     * @param hierarchy The contraction hierarchy of the graph.
+     * @param result Filled with the status, the distance and the path.
      */
-    bool Algorithms::canRelax(Graph& graph, size_t vertex_u, size_t vertex_v, int weight, vector<int>& distance, vector<size_t>& parent)
+    void Algorithms::contractionHierarchyShortestPath(const Graph& graph, size_t start, size_t end, const ContractionHierarchy& hierarchy, PathResult& result)
     {
-        if (weight != 0 && distance[vertex_u] != INT_MAX && distance[vertex_u] + weight < distance[vertex_v])
+        result.path = hierarchy.path(graph, start, end);
+
+        // Check if the end point is reachable
+        if (result.path.empty()) 
         {
-            // Check that v is not the parent of u
-            // This condition handles a specific case in undirected graphs where an edge v->u
-            // can lead to an unnecessary cycle
-            if (parent[vertex_u] != vertex_v)
-            {
-                return true;
-            }
+            result.status = PathStatus::NoPath;
+            return;
+        }
+
+        // The hierarchy only reports the vertices, so the distance is summed along the path
+        const AdjacencyIndex& edges = graph.getOutEdges();
+        result.status = PathStatus::Found;
+        result.distance = 0;
+        for (size_t i = 1; i < result.path.size(); i++) 
+        {
+            result.distance += edges.findWeight(result.path[i - 1], result.path[i]);
         }
-        return false;
     }
 
 
     /**
-     * @brief This auxiliary function finds the shortest path between two vertices using Dijkstra's algorithm.
+     * @brief This auxiliary function finds the vertex with the minimum distance that has not been visited yet.
      * 
-     * Dijkstra's algorithm is used for finding the shortest path from a single source vertex
-     * to a single destination vertex in a graph with non-negative edge weights.
+     * This is a function used by Dijkstra's algorithm to select the next vertex to visit.
+     * With SSE2 it first finds the minimum four lanes at a time and then the first vertex that holds it.
      *
-     * @param graph The graph.
-     * @param start The index of the start vertex.
-     * @param end The index of the end vertex.
-     * @return A string representing the shortest path or a message indicating no path exists.
+     * @param key The distance of every unvisited vertex from the start vertex (INT_MAX for visited vertices).
+     * @return The smallest index of a vertex with the smallest distance, or SIZE_MAX if every key is INT_MAX.
      */
-    string Algorithms::dijkstraShortestPath(Graph& graph, size_t start, size_t end) 
+    size_t Algorithms::findMinDistanceVertex(const vector<int>& key) 
     {
-        size_t numVertices = graph.getNumVertices();    // A variable to store the number of vertices in the graph
-        vector<int> distance(numVertices, INT_MAX);     // Initialize distance vector to infinity
-        vector<size_t> parent(numVertices, INT_MAX);    // Initialize parent vector for path building
-        vector<bool> visited(numVertices, false);       // Initialize visited vector to Keep track of visited nodes to avoid revisiting
-
-        distance[start] = 0;
+        size_t numVertices = key.size();
+        const int* data = key.data();
+        int minDistance = INT_MAX;          // We will start with the largest possible distance
+        size_t vertex_v = 0;
 
-        // Find the unvisited vertex with the smallest distance
-        for (size_t i = 0; i < numVertices; i++) 
+#ifdef __SSE2__
+        // Find the minimum distance, four vertices at a time
+        __m128i best = _mm_set1_epi32(INT_MAX);
+        for (; vertex_v + 4 <= numVertices; vertex_v += 4) 
         {
-            size_t minVertex = findMinDistanceVertex(distance, visited);
-
-            // If no vertex is found break from the loop, since the start is not connected to any vertex
-            if (minVertex == INT_MAX) 
-            {
-                break;
-            }
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + vertex_v));
+            __m128i smaller = _mm_cmplt_epi32(values, best);
+            best = _mm_or_si128(_mm_and_si128(smaller, values), _mm_andnot_si128(smaller, best));
+        }
+        int lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), best);
+        minDistance = min(min(lanes[0], lanes[1]), min(lanes[2], lanes[3]));
+#endif
+        for (; vertex_v < numVertices; vertex_v++) 
+        {
+            minDistance = min(minDistance, data[vertex_v]);
+        }
 
-            visited[minVertex] = true;      // Mark the currect vertex as visited
+        // Every vertex was visited or is unreachable
+        if (minDistance == INT_MAX) 
+        {
+            return SIZE_MAX;
+        }
 
-            for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++) 
+        // Find the first vertex with the minimum distance
+        vertex_v = 0;
+#ifdef __SSE2__
+        __m128i target = _mm_set1_epi32(minDistance);
+        for (; vertex_v + 4 <= numVertices; vertex_v += 4) 
+        {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + vertex_v));
+            int equal = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, target)));
+            if (equal != 0) 
             {
-                int weight = graph.getAdjacencyMatrix()[minVertex][vertex_v];                  // A variable to store the weight of the edge minVertex->v
-                // Relax the edge
-                if (weight != 0 && !visited[vertex_v] && distance[minVertex] != INT_MAX &&
-                distance[minVertex] + weight < distance[vertex_v]) 
-                {
-                    distance[vertex_v] = distance[minVertex] + weight;     // Update the distance to vertex v
-                    parent[vertex_v] = minVertex;                          // Set minVertex as the parent of v
-                }
+                return vertex_v + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(equal)));
             }
         }
-
-        // Check if the end point is reachable
-        if (distance[end] == INT_MAX) 
+#endif
+        while (data[vertex_v] != minDistance) 
         {
-            return "No path exists between " + to_string(start) + " and " + to_string(end);
+            vertex_v++;
         }
-
-        // Build the shortest path
-        string path = buildPath(start, end, parent);
-
-        return path;
+        return vertex_v;
     }
 
 
     /**
-     * @brief This auxiliary function finds the vertex with the minimum distance that has not been visited yet.
-     * 
-     * This is a function used by Dijkstra's algorithm to select the next vertex to visit.
+     * @brief This auxiliary function relaxes all the edges leaving a vertex, given the row of the vertex in a dense matrix.
+     *
+     * With SSE2 four edges are relaxed at a time (sums that overflow an int are ignored). The weights must be non-negative,
+     * so already visited vertices are never improved.
      *
-     * @param distance A vector of distances from the start vertex.
-     * @param visited A vector indicating whether each vertex has been visited.
-     * @return The index of the vertex with the smallest distance that has not been visited.
+     * @param row The weights of the edges leaving vertex_u (0 means no edge).
+     * @param vertex_u The vertex whose edges are relaxed.
+     * @param distance The vector storing the distances from the start vertex to each vertex.
+     * @param key The distances of the unvisited vertices, updated together with distance.
+     * @param parent The vector storing the parent of each vertex in the shortest path tree.
      */
-    size_t Algorithms::findMinDistanceVertex(vector<int>& distance, vector<bool>& visited) 
+    void Algorithms::relaxDenseRow(const int* row, size_t vertex_u, vector<int>& distance, vector<int>& key, vector<size_t>& parent)
     {
-        size_t minVertex = INT_MAX;
-        int minDistance = INT_MAX;          // We will start with the largest possible distance
+        size_t numVertices = distance.size();
+        int distance_u = distance[vertex_u];
+        size_t vertex_v = 0;
+
+#ifdef __SSE2__
+        __m128i base = _mm_set1_epi32(distance_u);
+        __m128i zero = _mm_setzero_si128();
+        __m128i minusOne = _mm_set1_epi32(-1);
+        for (; vertex_v + 4 <= numVertices; vertex_v += 4) 
+        {
+            __m128i weights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + vertex_v));
+            __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(distance.data() + vertex_v));
+            __m128i candidate = _mm_add_epi32(base, weights);
+
+            // An edge improves v if it exists, the sum did not overflow, and the sum is shorter
+            __m128i improves = _mm_and_si128(_mm_andnot_si128(_mm_cmpeq_epi32(weights, zero), _mm_cmpgt_epi32(current, candidate)),
+                                             _mm_cmpgt_epi32(candidate, minusOne));
+            int lanes = _mm_movemask_ps(_mm_castsi128_ps(improves));
+            if (lanes == 0) 
+            {
+                continue;
+            }
 
-        // Iterate through all vertices
-        for (size_t vertex_v = 0; vertex_v < distance.size(); vertex_v++) 
+            __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key.data() + vertex_v));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(distance.data() + vertex_v),
+                             _mm_or_si128(_mm_and_si128(improves, candidate), _mm_andnot_si128(improves, current)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(key.data() + vertex_v),
+                             _mm_or_si128(_mm_and_si128(improves, candidate), _mm_andnot_si128(improves, keys)));
+            for (size_t lane = 0; lane < 4; lane++) 
+            {
+                if ((lanes >> lane) & 1) 
+                {
+                    parent[vertex_v + lane] = vertex_u;
+                }
+            }
+        }
+#endif
+        for (; vertex_v < numVertices; vertex_v++) 
         {
-            // Update the vertex with the minimum distance that has not been visited
-            if (!visited[vertex_v] && distance[vertex_v] < minDistance) 
+            long long candidate = static_cast<long long>(distance_u) + row[vertex_v];
+            if (row[vertex_v] != 0 && candidate < distance[vertex_v]) 
             {
-                minVertex = vertex_v;
-                minDistance = distance[vertex_v];
+                distance[vertex_v] = static_cast<int>(candidate);     // Update the distance to vertex v
+                key[vertex_v] = static_cast<int>(candidate);
+                parent[vertex_v] = vertex_u;                          // Set u as the parent of v
             }
         }
-
-        return minVertex;
     }
 
 
@@ -607,82 +3087,78 @@ namespace ariel {
      * @param start The start vertex of the path.
      * @param end The end vertex of the path.
      * @param parent The vector containing each vertex's parent in the path.
-     * @return A string representing the path or an empty string if no path exists.
+     * @param path Filled with the vertices of the path from start to end, or cleared if no path exists.
      */
-    string Algorithms::buildPath(size_t start, size_t end, vector<size_t>& parent) 
+    void Algorithms::buildPath(size_t start, size_t end, const vector<size_t>& parent, vector<size_t>& path) 
     {
-        string path;
+        path.clear();
         size_t current = end;
 
-        // If no path exists from start to end, return an empty string
-        if (parent[current] == INT_MAX) 
+        // If no path exists from start to end, leave the path empty
+        if (parent[current] == SIZE_MAX) 
         {
-            return "";
+            return;
         }
 
-        // Traverse backwards from end to start using the parent vector
+        // Traverse backwards from end to start using the parent vector, then put the path in order
         while (current != start)
         {
-            path.insert(0, "->" + to_string(current));
+            path.push_back(current);
             current = parent[current];
         }
-
-        // Add the start vertex to the path
-        path = to_string(start) + path;
-
-        return path;
+        path.push_back(start);
+        reverse(path.begin(), path.end());
     }
 
    
     /**
      * @brief This auxiliary function uses DFS to detect a cycle in the graph starting from a given vertex.
   
-     * @param graph The graph to be checked.
+     * @param edges The edges of the graph to be checked (sorted by target, so the neighbours are visited in index order).
      * @param vertex The current vertex that explored in the DFS.
      * @param visited A vector that tracks if each vertex already visited to avoid revisiting.
      * @param recStack A vector that tracks "active" vertices in the current recursion to find cycles.
      * @param parent A vector that stores the parent of each vertex, for building the circle (if found).
      * @param isDirected Boolean that give an undication if the graph is directed; that affects finding of back edges.
-     * @return A string representing the cycle, or an empty string if no cycle is found.
+     * @param cycle Filled with the vertices of the cycle, if one is found.
+     * @return true if a cycle is found; otherwise, false.
      */
-    string Algorithms::dfs_cycle(Graph& graph, size_t vertex, vector<bool>& visited, vector<bool>& recStack, vector<size_t>& parent, bool isDirected) 
+    bool Algorithms::dfs_cycle(const AdjacencyIndex& edges, size_t vertex, vector<bool>& visited, vector<bool>& recStack, vector<size_t>& parent, bool isDirected,
+                               vector<size_t>& cycle) 
     {
         visited[vertex] = true;         // Mark the vertex as visited
         recStack[vertex] = true;        // Mark the vertex as part of the recursion
 
-        for (size_t i = 0; i < graph.getNumVertices(); i++) 
+        for (size_t e = edges.offsets[vertex]; e < edges.offsets[vertex + 1]; e++) 
         {
-            if (graph.getAdjacencyMatrix()[vertex][i] != 0)     // Ensure there is an edge from vertex to i
+            size_t i = edges.targets[e];        // There is an edge from vertex to i
+            if (!visited[i])                    // If not visited, we will preform recursion
             {
-                if (!visited[i])                // If not visited, we will preform recursion
+                parent[i] = vertex;             // Set the parent of i to vertex
+                if (dfs_cycle(edges, i, visited, recStack, parent, isDirected, cycle)) 
                 {
-                    parent[i] = vertex;         // Set the parent of i to vertex
-                    string cycle = dfs_cycle(graph, i, visited, recStack, parent, isDirected);
-                    if (!cycle.empty()) 
-                    {
-                        return cycle;
-                    }
-                } 
+                    return true;
+                }
+            } 
 
-                // A check for cycle (directed or undirected avoiding parent)
-                else if (recStack[i] && (isDirected || parent[vertex] != i))  
+            // A check for cycle (directed or undirected avoiding parent)
+            else if (recStack[i] && (isDirected || parent[vertex] != i))  
+            {
+                // Build the cycle i->...->vertex->i, walking back from vertex
+                cycle.clear();
+                for (size_t current = vertex; current != i; current = parent[current])
                 {
-                    // Build the cycle
-                    string cycle = to_string(i);
-                    size_t current = vertex;
-                    while (current != i)
-                    {
-                        cycle.insert(0, to_string(current) + "->");
-                        current = parent[current];
-                    }
-                    cycle.insert(0, to_string(i) + "->");
-                    return cycle;
+                    cycle.push_back(current);
                 }
+                cycle.push_back(i);
+                reverse(cycle.begin(), cycle.end());
+                cycle.push_back(i);
+                return true;
             }
         }
 
         recStack[vertex] = false;   // Remove the vertex from the recursion vector
-        return "";  
+        return false;  
     }
 
 
@@ -692,13 +3168,14 @@ namespace ariel {
      * A graph is bipartite if it can be colored using two colors such that no two adjacent vertices
      * share the same color.
      *
-     * @param graph The graph to check.
+     * @param outEdges The edges of the graph to check.
+     * @param inEdges The reversed edges of the graph, so edges are followed in both directions.
      * @param currectVertex The vertex to start coloring.
      * @param colorVec A vector storing the color of each vertex, initialized to -1 (uncolored).
      * @param color The current color to use (0 or 1).
      * @return true if the graph can be colored bipartitely; otherwise, false.
      */
-    bool Algorithms::dfsCheck(Graph& graph, size_t currectVertex, vector<int>& colorVec, int color) 
+    bool Algorithms::dfsCheck(const AdjacencyIndex& outEdges, const AdjacencyIndex& inEdges, size_t currectVertex, vector<int>& colorVec, int color) 
     {
         if (colorVec[currectVertex] != -1) 
         {
@@ -708,27 +3185,20 @@ namespace ariel {
         // Color the current vertex
         colorVec[currectVertex] = color;
 
-        // Check all adjacent vertices for a valid coloring
-        for (size_t vertex_v = 0; vertex_v < graph.getNumVertices(); vertex_v++) 
+        // Check all adjacent vertices for a valid coloring: the edges from u, and the reverse direction for undirected graphs
+        for (size_t e = outEdges.offsets[currectVertex]; e < outEdges.offsets[currectVertex + 1]; e++) 
         {
-            // There's an edge from u to v
-            if (graph.getAdjacencyMatrix()[currectVertex][vertex_v] != 0)      
-            {  
-                // Color the adjacent vertex with the opposite color, and return false is contradiction discovered
-                if (!dfsCheck(graph, vertex_v, colorVec, 1 - color)) 
-                {
-                    return false;
-                }
+            // Color the adjacent vertex with the opposite color, and return false is contradiction discovered
+            if (!dfsCheck(outEdges, inEdges, outEdges.targets[e], colorVec, 1 - color)) 
+            {
+                return false;
             }
-
-            // Check reverse direction for undirected graphs
-            if (graph.getAdjacencyMatrix()[vertex_v][currectVertex] != 0) 
-            {  
-                // Color the adjacent vertex with the opposite color, and return false is contradiction discovered
-                if (!dfsCheck(graph, vertex_v, colorVec, 1 - color)) 
-                {
-                    return false;
-                }
+        }
+        for (size_t e = inEdges.offsets[currectVertex]; e < inEdges.offsets[currectVertex + 1]; e++) 
+        {
+            if (!dfsCheck(outEdges, inEdges, inEdges.targets[e], colorVec, 1 - color)) 
+            {
+                return false;
             }
         }
 
@@ -765,135 +3235,232 @@ namespace ariel {
      * @param graph The graph to be checked.
      * @return A pair of boolean values indicating if the graph is unweighted and if it has negative edges.
      */
-    pair<bool, bool> Algorithms::checkGraphType(Graph& graph) 
+    pair<bool, bool> Algorithms::checkGraphType(const Graph& graph) 
+    {
+        // The weight range is cached by the graph (a graph without edges has the range [0, 0])
+        int minWeight = graph.getMinWeight();
+        int maxWeight = graph.getMaxWeight();
+        bool isUnweighted = maxWeight == 0 || (minWeight == 1 && maxWeight == 1);
+        bool hasNegativeEdges = minWeight < 0;
+
+        return make_pair(isUnweighted, hasNegativeEdges);
+    }
+    
+
+    /**
+     * @brief This auxiliary function computes the shortest paths between all pairs of vertices of a sparse graph with Johnson's algorithm.
+     *
+     * If some weights are negative, the distances from a virtual source joined to every vertex (found by the same subtree
+     * disassembly as negativeCycle, but relaxing the edges back to the parent as well) are used as potentials p, and every
+     * weight w(u,v) becomes w(u,v) + p(u) - p(v) >= 0. Then a Dijkstra's search with a binary heap runs from every vertex;
+     * the sources are split between the threads (see Parallel). Time complexity: O(|V|*|E|*log|V|).
+     *
+     * @param graph The graph.
+     * @return The distance and the next hop between every pair of vertices, or an indication of a negative cycle.
+     */
+    AllPairsShortestPaths Algorithms::johnsonShortestPaths(const Graph& graph)
     {
-        bool isUnweighted = true;
-        bool hasNegativeEdges = false;
+        const AdjacencyIndex& edges = graph.getOutEdges();
         size_t numVertices = graph.getNumVertices();
+        AllPairsShortestPaths result;
+        result.hasNegativeCycle = false;
 
-        for (size_t i = 0; i < numVertices; i++) 
+        // Potentials that make every weight non-negative
+        vector<long long> potential(numVertices, 0);
+        vector<size_t> cycle;
+        if (graph.getMinWeight() < 0 && findNegativeCircle(graph, true, potential, cycle))
+        {
+            result.hasNegativeCycle = true;
+            return result;
+        }
+
+        result.distance.assign(numVertices, vector<long long>(numVertices, LLONG_MAX));
+        result.next.assign(numVertices, vector<size_t>(numVertices, SIZE_MAX));
+
+        Parallel::forRange(numVertices, 1, [&](size_t begin, size_t end)
         {
-            for (size_t j = 0; j < numVertices; j++) 
+            vector<long long> distance(numVertices, LLONG_MAX);     // The reweighted distances from the current source
+            vector<size_t> reached;                                 // The vertices with a distance, to reset them afterwards
+            priority_queue<pair<long long, size_t>, vector<pair<long long, size_t>>, greater<pair<long long, size_t>>> heap;
+
+            for (size_t source = begin; source < end; source++)
             {
-                int weight = graph.getAdjacencyMatrix()[i][j];
-                if (weight != 0 && weight != 1) 
+                vector<size_t>& next = result.next[source];
+                distance[source] = 0;
+                next[source] = source;
+                reached.push_back(source);
+                heap.push(make_pair(0LL, source));
+
+                while (!heap.empty())
                 {
-                    isUnweighted = false;
+                    long long key = heap.top().first;
+                    size_t vertex_u = heap.top().second;
+                    heap.pop();
+
+                    // Skip stale entries of vertices that were already settled
+                    if (key > distance[vertex_u])
+                    {
+                        continue;
+                    }
+                    for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                    {
+                        size_t vertex_v = edges.targets[e];
+                        long long candidate = key + edges.weights[e] + potential[vertex_u] - potential[vertex_v];
+                        if (candidate < distance[vertex_v])
+                        {
+                            if (distance[vertex_v] == LLONG_MAX)
+                            {
+                                reached.push_back(vertex_v);
+                            }
+                            distance[vertex_v] = candidate;
+                            next[vertex_v] = vertex_u == source ? vertex_v : next[vertex_u];
+                            heap.push(make_pair(candidate, vertex_v));
+                        }
+                    }
                 }
-                if (weight < 0) 
+
+                // Undo the reweighting, and clear the distances for the next source
+                for (size_t i = 0; i < reached.size(); i++)
                 {
-                    hasNegativeEdges = true;
+                    size_t vertex_v = reached[i];
+                    result.distance[source][vertex_v] = distance[vertex_v] - potential[source] + potential[vertex_v];
+                    distance[vertex_v] = LLONG_MAX;
                 }
+                reached.clear();
             }
-        }
+        });
 
-        return make_pair(isUnweighted, hasNegativeEdges);
+        return result;
     }
-    
+
 
     /**
-     * @brief This auxiliary function finds a negative cycle (if exists) in a graph using a Bellman-Ford algorithm.
+     * @brief This auxiliary function finds a negative cycle (if exists) in a graph using Tarjan's subtree disassembly.
      * 
-     * This function attempts to detect a negative cycle by relaxing edges repeatedly and try to find an indication for a cycle.
+     * A queue-based Bellman-Ford runs from a virtual source joined to every vertex by a 0 edge, and keeps its shortest path
+     * tree as a list in preorder. When u->v is relaxed, the subtree of v is removed from the tree (the distances in it are
+     * out of date, so its vertices are not scanned until they improve again); if u is in that subtree, the tree path
+     * v->...->u and the edge u->v close a negative cycle, which is reported at once. As in the shortest path search, an
+     * edge u->v is not relaxed when v is the parent of u (unless backtrack is set), so an undirected edge is not taken as
+     * a cycle.
      *
      * @param graph The graph in which to detect negative cycles.
-     * @return A string describing the cycle if found, or a message indicating no cycle exists.
+     * @param backtrack true to relax the edges back to the parent as well (then the distances are feasible potentials).
+     * @param distance Filled with the distance of every vertex from the virtual source, if no cycle is found.
+     * @param cycle Filled with the vertices of the cycle, if one is found.
+     * @return true if a negative cycle was found; otherwise, false.
      */
-    string Algorithms::findNegativeCircle(Graph& graph) 
+    bool Algorithms::findNegativeCircle(const Graph& graph, bool backtrack, vector<long long>& distance, vector<size_t>& cycle) 
     {
+        const AdjacencyIndex& edges = graph.getOutEdges();
         size_t numVertices = graph.getNumVertices();
-        vector<int> distance(numVertices, 0);
-        vector<size_t> parent(numVertices, SIZE_MAX);
-
-        // Relax edges V-1 times
-        for (int i = 0; i < numVertices - 1; i++)
+        size_t root = numVertices;                          // The virtual source
+
+        distance.assign(numVertices, 0);
+        vector<size_t> parent(numVertices, root);
+        vector<size_t> depth(numVertices + 1, 1);           // The depth of each vertex in the tree
+        vector<size_t> nextInTree(numVertices + 1);         // The tree in preorder, as a circular list through the root
+        vector<size_t> prevInTree(numVertices + 1);
+        vector<bool> inTree(numVertices, true);
+        vector<bool> inQueue(numVertices, true);
+        queue<size_t> pending;
+        depth[root] = 0;
+
+        // At first every vertex is a child of the virtual source
+        for (size_t vertex_u = 0; vertex_u <= numVertices; vertex_u++)
         {
-            relaxEdges(graph, distance, parent);
+            nextInTree[vertex_u] = vertex_u == numVertices ? 0 : vertex_u + 1;
+            prevInTree[vertex_u] = vertex_u == 0 ? root : vertex_u - 1;
+            if (vertex_u < numVertices)
+            {
+                pending.push(vertex_u);
+            }
         }
 
-        // Check for negative cycle on the V-th iteration
-        if (relaxEdges(graph, distance, parent))
+        while (!pending.empty())
         {
-            // Find a vertex in the negative cycle
-            size_t vertex = findNegativeCycleVertex(graph, distance, parent);
-            
-            // Build the negative cycle path
-            string cycle = buildNegativeCycle(graph, vertex, parent);
-            return cycle;
-        }
-
-        return "No negative cycle exists";
-    }
+            size_t vertex_u = pending.front();
+            pending.pop();
+            inQueue[vertex_u] = false;
 
+            // A vertex whose subtree was removed waits until its own distance improves
+            if (!inTree[vertex_u])
+            {
+                continue;
+            }
 
-    /**
-     * @brief This auxiliary function finds a vertex in a negative cycle.
-    *   
-    * @param graph The graph.
-    * @param distance The vector storing the distances from the source vertex to each vertex.
-    * @param parent The vector storing the parent of each vertex in the shortest path tree.
-    * @return The vertex in the negative cycle.
-    */
-    size_t Algorithms::findNegativeCycleVertex(Graph& graph, vector<int>& distance, vector<size_t>& parent)
-    {
-        size_t numVertices = graph.getNumVertices();
-        
-        // Iterate over all vertices in the graph
-        for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++)
-        {
-            // For each vertex v, iterate over all vertices u
-            for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+            for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
             {
-                // Get the weight of the edge from vertex u to vertex v
-                int weight = graph.getAdjacencyMatrix()[vertex_u][vertex_v];
-                
-                // If the edge can be relaxed, it means we found a vertex (vertex_v)
-                // that is part of a negative cycle
-                if (canRelax(graph, vertex_u, vertex_v, weight, distance, parent))
+                size_t vertex_v = edges.targets[e];
+                long long candidate = distance[vertex_u] + edges.weights[e];
+                if (candidate >= distance[vertex_v] || (!backtrack && parent[vertex_u] == vertex_v))
+                {
+                    continue;
+                }
+                if (vertex_v == vertex_u)
+                {
+                    cycle.assign(2, vertex_u);
+                    return true;
+                }
+
+                if (inTree[vertex_v])
+                {
+                    // Remove v and its subtree (the vertices after v in preorder that are deeper than v)
+                    size_t before = prevInTree[vertex_v];
+                    size_t current = nextInTree[vertex_v];
+                    while (current != root && depth[current] > depth[vertex_v])
+                    {
+                        if (current == vertex_u)
+                        {
+                            buildNegativeCycle(vertex_v, vertex_u, parent, cycle);
+                            return true;
+                        }
+                        inTree[current] = false;
+                        current = nextInTree[current];
+                    }
+                    nextInTree[before] = current;
+                    prevInTree[current] = before;
+                }
+
+                // Hang v under u, right after u in preorder
+                distance[vertex_v] = candidate;
+                parent[vertex_v] = vertex_u;
+                depth[vertex_v] = depth[vertex_u] + 1;
+                inTree[vertex_v] = true;
+                nextInTree[vertex_v] = nextInTree[vertex_u];
+                prevInTree[nextInTree[vertex_u]] = vertex_v;
+                nextInTree[vertex_u] = vertex_v;
+                prevInTree[vertex_v] = vertex_u;
+                if (!inQueue[vertex_v])
                 {
-                    return vertex_u;
+                    inQueue[vertex_v] = true;
+                    pending.push(vertex_v);
                 }
             }
         }
-        return 0; 
+
+        cycle.clear();
+        return false;
     }
 
+
     /**
      * @brief This auxiliary function builds the negative cycle path.
      *
-     * @param graph The graph.
-     * @param vertex_v The vertex involved in the negative cycle.
+     * @param vertex_v The first vertex of the cycle.
+     * @param vertex_u The last vertex of the cycle before returning to vertex_v (a descendant of vertex_v in the tree).
      * @param parent The vector storing the parent of each vertex in the shortest path tree.
-     * @return A string representing the negative cycle path.
+     * @param cycle Filled with the vertices of the cycle, v->...->u->v.
      */
-    string Algorithms::buildNegativeCycle(Graph& graph, size_t vertex_v, vector<size_t>& parent)
+    void Algorithms::buildNegativeCycle(size_t vertex_v, size_t vertex_u, const vector<size_t>& parent, vector<size_t>& cycle)
     {
-        string cycle;
-        size_t current = vertex_v;
-        size_t numVertices = graph.getNumVertices();
-        vector<bool> visited(numVertices, false);
-        size_t startVertex = current;
-        stack<size_t> path;
-
-        do
-        {
-            visited[current] = true;
-            path.push(current);
-            current = parent[current];
-        } while (current != startVertex);
-
-        path.push(startVertex);
-
-        while (!path.empty())
+        cycle.clear();
+        for (size_t current = vertex_u; current != vertex_v; current = parent[current])
         {
-            cycle += to_string(path.top());
-            path.pop();
-            if (!path.empty())
-            {
-                cycle += "->";
-            }
+            cycle.push_back(current);
         }
-
-        return cycle;
+        cycle.push_back(vertex_v);
+        reverse(cycle.begin(), cycle.end());
+        cycle.push_back(vertex_v);
     }
 }
\ No newline at end of file
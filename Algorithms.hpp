@@ -4,12 +4,94 @@
 #define ALGORITHMS_H
 
 #include "Graph.hpp"
+#include "LandmarkIndex.hpp"
+#include "ContractionHierarchy.hpp"
 #include <string>
+#include <functional>
 
 using namespace std;
 
 namespace ariel {
 
+/**
+* @brief This struct represents the connected components of a graph.
+*/
+struct ConnectedComponents
+{
+    vector<size_t> label;       // The component of each vertex (0 .. number of components - 1)
+    vector<size_t> size;        // The number of vertices in each component
+};
+
+
+/**
+* @brief This struct represents the shortest paths between all pairs of vertices of a graph.
+*/
+struct AllPairsShortestPaths
+{
+    vector<vector<long long>> distance;     // The length of a shortest path u->v (LLONG_MAX if v is unreachable from u)
+    vector<vector<size_t>> next;            // The vertex after u on that path (u if v = u, SIZE_MAX if v is unreachable)
+    bool hasNegativeCycle;                  // true if the graph has a negative cycle (the matrices are then empty)
+};
+
+
+/**
+* @brief This enum represents the outcome of a shortest path query.
+*/
+enum class PathStatus
+{
+    Found,              // A shortest path exists
+    NoPath,             // The end vertex is unreachable from the start vertex
+    SameVertex,         // The start and end vertices are the same vertex
+    InvalidVertex,      // The start or end vertex is not a vertex of the graph
+    NegativeCycle       // The graph contains a negative cycle
+};
+
+
+/**
+* @brief This struct represents the result of a shortest path query.
+*/
+struct PathResult
+{
+    PathStatus status;          // The outcome of the query
+    size_t start;               // The start vertex of the query
+    size_t end;                 // The end vertex of the query
+    long long distance;         // The length of the path (0 unless a path was found)
+    vector<size_t> path;        // The vertices of the path from start to end (empty unless a path was found)
+};
+
+
+/**
+* @brief This struct represents the shortest paths from one vertex to every vertex of a graph.
+*/
+struct ShortestPathTree
+{
+    size_t source;                  // The vertex the paths start from
+    vector<long long> distance;     // The length of a shortest path to every vertex (LLONG_MAX if it is unreachable)
+    vector<size_t> parent;          // The vertex before every vertex on that path (SIZE_MAX for the source and unreachable vertices)
+    bool hasNegativeCycle;          // true if a negative cycle is reachable from the source (then no vertex has a distance)
+};
+
+
+/**
+* @brief This struct represents the result of a cycle query.
+*/
+struct CycleResult
+{
+    bool found;                 // true if a cycle was found
+    vector<size_t> cycle;       // The vertices of the cycle, with its first vertex repeated at the end (empty if none was found)
+};
+
+
+/**
+* @brief This struct represents the result of a bipartite query.
+*/
+struct BipartiteResult
+{
+    bool isBipartite;           // true if the graph is bipartite
+    vector<int> label;          // The side of every vertex: 0 for A, 1 for B (empty if the graph is not bipartite)
+};
+
+
 class Algorithms {
 
     public:
@@ -20,31 +102,153 @@ class Algorithms {
          * @param graph The graph to check.
          * @return true if all vertices are reachable; otherwise, false.
          */
-        static bool isConnected(Graph& graph);
+        static bool isConnected(const Graph& graph);
 
 
         /**
-         * This function checks if a given graph is strongly connected by applying BFS from each vertex.
+         * This function checks if a given graph is strongly connected, i.e. if it has a single strongly connected component.
          *
          * @param graph The graph to check.
          * @return true if the graph is strongly connected; otherwise, false.
          */
-        static bool isStronglyConnected(Graph& graph);
+        static bool isStronglyConnected(const Graph& graph);
+
+
+        /**
+         * @brief This method finds the strongly connected components of a graph using an iterative Tarjan's algorithm.
+         *
+         * Time complexity: O(|V|+|E|). Components are numbered in reverse topological order: every edge between two
+         * components goes from a component with a larger id to a component with a smaller id.
+         *
+         * @param graph The graph.
+         * @return The id of the component of each vertex (0 .. number of components - 1).
+         */
+        static vector<size_t> stronglyConnectedComponents(const Graph& graph);
+
+
+        /**
+         * @brief This method labels the connected components of a graph (the weakly connected components of a directed graph).
+         *
+         * The edges are merged into a disjoint-set structure; large graphs are processed in parallel chunks using lock-free
+         * unions. Components are numbered in order of their smallest vertex, so vertex 0 is always in component 0.
+         *
+         * @param graph The graph.
+         * @return The component label of each vertex and the size of each component.
+         */
+        static ConnectedComponents connectedComponents(const Graph& graph);
+
+
+        /**
+         * @brief This method builds the condensation of a graph: the DAG with one vertex per strongly connected component.
+         *
+         * Time complexity: O(|V|+|E|). Vertex i of the result is component i of stronglyConnectedComponents, and the edges
+         * between two components are merged into a single edge weighted by the lightest of them. The result uses dense
+         * storage when the matrix is not larger than the sparse index, and sparse storage otherwise.
+         *
+         * @param graph The graph.
+         * @return The condensed graph (an empty graph if the given graph has no vertices).
+         */
+        static Graph condensation(const Graph& graph);
+
+
+        /**
+         * @brief This method computes the number of edges on the shortest paths from several sources to every vertex.
+         *
+         * The searches run as a multi-source BFS: up to 64 sources advance together, one bit per source per vertex, so every
+         * neighbour scan is shared by the whole batch. Batches run in parallel.
+         *
+         * @param graph The graph.
+         * @param sources The source vertices.
+         * @return For each source, the hop distance to every vertex (SIZE_MAX for unreachable vertices).
+         * @throws If a source is not a vertex of the graph throw invalid_argument exception
+         */
+        static vector<vector<size_t>> hopDistances(const Graph& graph, const vector<size_t>& sources);
+
+
+        /**
+         * @brief This method computes the set of vertices reachable from each of several sources.
+         *
+         * The searches run as a multi-source BFS, 64 sources per batch (see hopDistances).
+         *
+         * @param graph The graph.
+         * @param sources The source vertices.
+         * @return For each source, a vector that marks the vertices reachable from it (including the source itself).
+         * @throws If a source is not a vertex of the graph throw invalid_argument exception
+         */
+        static vector<vector<bool>> reachability(const Graph& graph, const vector<size_t>& sources);
 
 
          /**
          * @brief This method finds the shortest path between two vertices in a given graph.
          *
          * @note: The method uses a strategy to choose the appropriate algorithm based on the properties of the graph (weighted/unweighted, containts negative edges or not).
-         * It uses BFS for unweighted graphs (time complexity: O(|V|+|E|)), Bellman-Ford for graphs with negative weights (time complexity: O(|V|*|E|)), 
-         * or Dijkstra's for non-negative weighted graphs (time complexity: O(|V|*|V|)), and thus does not waste resources.
+         * It uses bidirectional BFS for unweighted graphs (time complexity: O(|V|+|E|)), Bellman-Ford for graphs with negative weights (time complexity: O(|V|*|E|)), 
+         * or Dijkstra's for non-negative weighted graphs (time complexity: O(|V|*|V|) for dense graphs; for sparse graphs O(|E|+|V|*C) with buckets
+         * when the largest weight C is small, O(|E|+|V|*log(C)) with a radix heap when it is moderate, O((|V|+|E|)*log|V|) with a bidirectional
+         * search over binary heaps otherwise), and thus does not waste resources. Sparse graphs with an ALT landmark index (built on
+         * request, see Graph::getLandmarks) are searched with A*. A graph with a contraction hierarchy (see
+         * Graph::getContractionHierarchy) is queried through the hierarchy instead. Graphs with at least 65536 vertices are searched
+         * by all the threads (see Parallel): with a parallel Bellman-Ford if there are negative weights, and with delta-stepping
+         * otherwise, unless several threads are not available or a landmark index was built (see Graph::getLandmarks).
          *
          * @param graph The graph.
          * @param start The start vertex.
          * @param end The end vertex.
+         * @return A string representing the path or a message if the path doesn't exist (see formatPath).
+         */
+        static string shortestPath(const Graph& graph, size_t start, size_t end);
+
+
+        /**
+         * @brief This method finds the shortest path between two vertices in a given graph, as in shortestPath above.
+         *
+         * The result is written into a buffer owned by the caller, so repeated queries reuse the memory of its path.
+         *
+         * @param graph The graph.
+         * @param start The start vertex.
+         * @param end The end vertex.
+         * @param result Filled with the status, the distance and the vertices of the path.
+         */
+        static void shortestPath(const Graph& graph, size_t start, size_t end, PathResult& result);
+
+
+        /**
+         * @brief This method formats the result of a shortest path query as a string, e.g. "0->3->5".
+         *
+         * @param result The result of the query.
          * @return A string representing the path or a message if the path doesn't exist.
          */
-        static string shortestPath(Graph& graph, size_t start, size_t end);
+        static string formatPath(const PathResult& result);
+
+
+        /**
+         * @brief This method computes the shortest paths from a vertex to every vertex of a given graph.
+         *
+         * The search is chosen as in shortestPath: BFS for unweighted graphs, Bellman-Ford for graphs with negative weights, and
+         * Dijkstra's with a binary heap otherwise (time complexity: O((|V|+|E|)*log|V|)), or delta-stepping on all the threads
+         * for graphs with at least 65536 vertices (see Parallel). Without negative weights the parent of a vertex is its
+         * in-neighbour on a shortest path with the smallest (distance, index), so the paths are the ones shortestPath returns;
+         * with negative weights they are the ones Bellman-Ford finds. One search replaces a query per target (see treePath).
+         *
+         * @param graph The graph.
+         * @param source The vertex to start from.
+         * @return The distance and the parent of every vertex, or an indication of a negative cycle.
+         * @throws If the source is not a vertex of the graph throw invalid_argument exception
+         */
+        static ShortestPathTree singleSourceShortestPaths(const Graph& graph, size_t source);
+
+
+        /**
+         * @brief This method reads the shortest path to a vertex from a shortest path tree (time complexity: O(length of the path)).
+         *
+         * The statuses are the ones shortestPath reports, except that a negative cycle reachable from the source is reported
+         * for every end vertex.
+         *
+         * @param tree The shortest path tree (see singleSourceShortestPaths).
+         * @param end The end vertex.
+         * @param result Filled with the status, the distance and the vertices of the path.
+         */
+        static void treePath(const ShortestPathTree& tree, size_t end, PathResult& result);
         
         
         /**
@@ -55,7 +259,25 @@ class Algorithms {
          * @param graph The graph to check.
          * @return A string representing the cycle if one exists; otherwise, "0".
          */
-        static string isContainsCycle(Graph& graph);
+        static string isContainsCycle(const Graph& graph);
+
+
+        /**
+         * @brief This method checks if there is a cycle in the graph, as in isContainsCycle above.
+         *
+         * @param graph The graph to check.
+         * @param result Filled with the vertices of the cycle, if one exists.
+         */
+        static void isContainsCycle(const Graph& graph, CycleResult& result);
+
+
+        /**
+         * @brief This method formats the result of a cycle query as a string, e.g. "0->1->2->0".
+         *
+         * @param result The result of the query.
+         * @return A string representing the cycle, or an empty string if no cycle was found.
+         */
+        static string formatCycle(const CycleResult& result);
 
 
         /**
@@ -67,18 +289,74 @@ class Algorithms {
          * @param graph The graph to check.
          * @return A string indicating if the graph is bipartite; otherwise, an error message.
          */
-        static string isBipartite(Graph& graph);
+        static string isBipartite(const Graph& graph);
+
+
+        /**
+         * @brief This function checks if a graph is bipartite, as in isBipartite above.
+         *
+         * @param graph The graph to check.
+         * @param result Filled with the side of every vertex, if the graph is bipartite.
+         */
+        static void isBipartite(const Graph& graph, BipartiteResult& result);
+
+
+        /**
+         * @brief This method formats the result of a bipartite query as a string, e.g. "The graph is bipartite: A={0,2}, B={1}".
+         *
+         * @param result The result of the query.
+         * @return A string indicating if the graph is bipartite; otherwise, an error message.
+         */
+        static string formatBipartition(const BipartiteResult& result);
 
 
         /**
          * @brief This method checks for a negative cycle in the graph.
          *
-         * This method checks for negative cycles using a variant of the Bellman-Ford algorithm, which is capable of detecting such cycles.
+         * Negative self-loops and neighbours whose edges have different weights with a negative sum are checked first; longer
+         * cycles are found with Tarjan's subtree disassembly (see findNegativeCircle), which reports the first cycle it closes.
          *
          * @param graph The graph to check.
          * @return A string represents a negative cycle if exists; otherwise, "No negative cycle exists".
          */
-        static string negativeCycle(Graph& graph);
+        static string negativeCycle(const Graph& graph);
+
+
+        /**
+         * @brief This method checks for a negative cycle in the graph, as in negativeCycle above.
+         *
+         * @param graph The graph to check.
+         * @param result Filled with the vertices of a negative cycle, if one exists.
+         */
+        static void negativeCycle(const Graph& graph, CycleResult& result);
+
+
+        /**
+         * @brief This method computes the shortest paths between all pairs of vertices.
+         *
+         * Dense graphs use a cache-blocked Floyd-Warshall (time complexity: O(|V|^3)) that splits every round between the threads
+         * (see Parallel). When no path can overflow an int, four distances are relaxed at a time with SSE2; otherwise the
+         * distances are long long. A negative distance from a vertex to itself means a negative cycle, which stops the search.
+         * Sparse graphs (fewer than |V|^2/16 edges) use Johnson's algorithm instead (time complexity: O(|V|*|E|*log|V|)). Every
+         * closed walk counts, so an undirected edge with a negative weight is a negative cycle here (unlike in negativeCycle).
+         *
+         * @param graph The graph.
+         * @return The distance and the next hop between every pair of vertices, or an indication of a negative cycle.
+         */
+        static AllPairsShortestPaths allPairsShortestPaths(const Graph& graph);
+
+
+        /**
+         * @brief This method computes the number of edges on the shortest paths between all pairs of vertices.
+         *
+         * Dense undirected graphs (at least |V|^2/4 edges) use Seidel's algorithm: O(log|V|) boolean matrix products on bitmaps,
+         * 8 rows per table lookup (time complexity: O(|V|^3*log|V|/(64*8))). Other graphs run a multi-source BFS from every
+         * vertex (see hopDistances). The weights are ignored, as in hopDistances.
+         *
+         * @param graph The graph.
+         * @return For each vertex, the hop distance to every vertex (SIZE_MAX for unreachable vertices).
+         */
+        static vector<vector<size_t>> allPairsHopDistances(const Graph& graph);
 
     private:
 
@@ -92,7 +370,22 @@ class Algorithms {
          * @param parent A vector to track the parent of the vertices (extents the classic BFS for finding the shortest path).
          * @param parent A vector to track the parent of each vertex, used for rebuilding paths (extents the classic BFS for finding the shortest path).
          */
-        static void bfs(Graph& graph, size_t startVertex, vector<bool>& visited, vector<size_t>& parent, size_t end, bool reverse);
+        static void bfs(const Graph& graph, size_t startVertex, vector<bool>& visited, vector<size_t>& parent, size_t end, bool reverse);
+
+
+        /**
+         * @brief This auxiliary function runs a multi-source BFS from batches of up to 64 sources.
+         *
+         * Bit i of a vertex's masks belongs to source batch * 64 + i. Each level, every vertex with active bits pushes them
+         * to its neighbours that have not seen them yet. Batches are independent and run in parallel.
+         *
+         * @param graph The graph.
+         * @param sources The source vertices.
+         * @param visit Called once per vertex and level with the bits of the sources that reach the vertex at that level
+         * (the arguments are the batch, the vertex, the bits and the level); calls from different batches may run concurrently.
+         * @throws If a source is not a vertex of the graph throw invalid_argument exception
+         */
+        static void multiSourceBfs(const Graph& graph, const vector<size_t>& sources, const function<void(size_t, size_t, uint64_t, size_t)>& visit);
 
 
         /**
@@ -109,57 +402,95 @@ class Algorithms {
          * @param end The ending vertex for potential paths.
          * @param subgraph A Graph that will be contained the resulting subgraph.
          */
-        static void extractSubgraph(Graph& graph, size_t start, size_t end, Graph& subgraph);
+        static void extractSubgraph(const Graph& graph, size_t start, size_t end, Graph& subgraph);
 
 
         /**
-         * @brief This auxiliary function finds the shortest path using BFS for unweighted graphs.
+         * @brief This auxiliary function finds the shortest path using a bidirectional BFS for unweighted graphs.
          *
-         * This function returns the shortest path by building the path itself.
+         * A forward search from start (over the out-edges) and a backward search from end (over the in-edges) expand a
+         * whole level at a time, always on the side with the smaller frontier, and stop once the sum of their depths
+         * reaches the length of the shortest path seen so far. The path is rebuilt by buildBidirectionalPath.
          *
          * @param graph The graph.
          * @param start The start vertex.
          * @param end The end vertex.
-         * @return A string representing the shortest path.
+         * @param result Filled with the status, the distance and the path.
          */
-        static string bfsShortestPath(Graph& graph, size_t start, size_t end);
+        static void bfsShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result);
+
+
+        /**
+         * @brief This auxiliary function rebuilds the path found by a bidirectional search.
+         *
+         * It returns the same path as a forward search from start: the parent of a vertex is its in-neighbour on a shortest
+         * path with the smallest (distance from start, index). First the vertices on shortest paths are marked, starting at the
+         * places where the two searches meet and following the edges that are tight in either search; then the path is
+         * walked back from end.
+         *
+         * @param graph The graph.
+         * @param start The start vertex.
+         * @param end The end vertex.
+         * @param length The length of the shortest path.
+         * @param forward The exact distance from start of every vertex settled by the forward search (LLONG_MAX for others).
+         * @param backward The exact distance to end of every vertex settled by the backward search (LLONG_MAX for others).
+         * @param forwardSettled The vertices settled by the forward search.
+         * @param path Filled with the vertices of the path from start to end.
+         */
+        static void buildBidirectionalPath(const Graph& graph, size_t start, size_t end, long long length, const vector<long long>& forward,
+                                           const vector<long long>& backward, const vector<size_t>& forwardSettled, vector<size_t>& path);
 
 
         /**
          * @brief This auxiliary function finds the shortest path in a graph with possible negative weights using Bellman-Ford algorithm.
          *
-         * This algorithm also checks for negative cycles and if detected, returns an error message.
+         * This algorithm also checks for negative cycles and if detected, reports one in the result.
+         * Instead of relaxing every edge V-1 times, each pass rescans only the vertices whose distance changed (in index order,
+         * so the result is the same as relaxing all the edges), and the search stops after the first quiet pass. A negative
+         * cycle is reported as soon as a vertex is reached by a walk of V edges, or if the V-th pass still relaxes an edge.
          *
          * @param graph The graph.
          * @param start The starting vertex.
          * @param end The destination vertex.
-         * @return A string representing the path or an error message if a negative cycle is detected.
+         * @param result Filled with the status, the distance and the path.
          */
-        static string bellmanFordShortestPath(Graph& graph, size_t start, size_t end);
+        static void bellmanFordShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result);
 
 
         /**
-         * @brief This auxiliary function relaxes the edges in the graph during the shortest path process.
+         * @brief This auxiliary function computes the distances from a vertex with Bellman-Ford algorithm, and their shortest path tree.
          *
-         * @param graph The graph on which the edges are relaxed.
-         * @param distance The vector storing the distances from the source vertex to each vertex.
-         * @param parent The vector storing the parent of each vertex in the shortest path tree.
+         * Instead of relaxing every edge V-1 times, each pass rescans only the vertices whose distance changed (in index order,
+         * so the result is the same as relaxing all the edges), and the search stops after the first quiet pass. A negative
+         * cycle is reported as soon as a vertex is reached by a walk of V edges, or if the V-th pass still relaxes an edge.
+         * The passes never relax an edge back to the parent, so every vertex is checked for such short cycles when it is
+         * first reached.
+         *
+         * @param graph The graph.
+         * @param source The vertex to start from.
+         * @param distance Filled with the distance of every vertex from the source (LLONG_MAX for unreachable vertices).
+         * @param parent Filled with the parent of every vertex (SIZE_MAX for the source and unreachable vertices).
+         * @return false if a negative cycle is reachable from the source; otherwise, true.
          */
-        static bool relaxEdges(Graph& graph, vector<int>& distance, vector<size_t>& parent);
+        static bool bellmanFordTree(const Graph& graph, size_t source, vector<long long>& distance, vector<size_t>& parent);
 
 
         /**
-         * @brief This auxiliary function checks if an edge can be relaxed.
+         * @brief This auxiliary function finds the shortest path in a large graph with possible negative weights using a parallel Bellman-Ford.
          *
-         * @param graph The graph containing the edge.
-         * @param vertex_u The source vertex of the edge.
-         * @param vertex_v The destination vertex of the edge.
-         * @param weight The weight of the edge.
-         * @param distance The vector storing the distances from the source vertex to each vertex.
-         * @param parent The vector storing the parent of each vertex in the shortest path tree.
-         * @return true if the edge can be relaxed, false otherwise.
+         * Each round, the vertices whose distance changed in the previous round are split between the threads, which relax
+         * their edges with an atomic minimum on the distances. If the distances still change in the V-th round, or if the
+         * parents (checked after rounds 16, 32, 64, ...) close a negative cycle, the graph contains a negative cycle. The path is
+         * the one with the fewest edges among the shortest paths, found by a BFS over the tight edges (so it does not depend on
+         * the number of threads). An undirected edge with a negative weight is not a cycle only because of the order in which the
+         * sequential search scans the edges, so such graphs are handed to bellmanFordShortestPath.
+         *
+         * @param graph The graph.
+         * @param start The starting vertex.
+         * @param end The destination vertex.
+         * @param result Filled with the status, the distance and the path.
          */
-        static bool canRelax(Graph& graph, size_t vertex_u, size_t vertex_v, int weight, vector<int>& distance, vector<size_t>& parent);
+        static void parallelBellmanFordShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result);
 
 
         /**
@@ -171,21 +502,149 @@ class Algorithms {
          * @param graph The graph.
          * @param start The index of the start vertex.
          * @param end The index of the end vertex.
-         * @return A string representing the shortest path or a message indicating no path exists.
+         * @param result Filled with the status, the distance and the path.
          */
-        static string dijkstraShortestPath(Graph& graph, size_t start, size_t end);
+        static void dijkstraShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result);
+
+
+        /**
+         * @brief This auxiliary function finds the shortest path between two vertices using a bidirectional Dijkstra's algorithm.
+         *
+         * A forward search from start (over the out-edges) and a backward search from end (over the in-edges) each keep a
+         * lazy-deletion binary heap, and the side with the smaller key is advanced. The search stops once the two smallest
+         * keys add up to more than the shortest path seen so far, so every vertex on a shortest path is settled by at least
+         * one side. The path is rebuilt by buildBidirectionalPath.
+         *
+         * @param graph The graph (with positive weights only).
+         * @param start The index of the start vertex.
+         * @param end The index of the end vertex.
+         * @param result Filled with the status, the distance and the path.
+         */
+        static void bidirectionalDijkstraShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result);
+
+
+        /**
+         * @brief This auxiliary function finds the shortest path between two vertices using A* steered by an ALT landmark index.
+         *
+         * The keys of the lazy-deletion binary heap are the distance from start plus the landmark lower bound on the distance
+         * to end. The bound is consistent, so every vertex is settled once with its exact distance. The search goes on until
+         * the smallest key exceeds the distance to end, so that every vertex on a shortest path is settled, and the path is
+         * rebuilt by buildBidirectionalPath (the same path as a forward Dijkstra's search).
+         *
+         * @param graph The graph (with positive weights only).
+         * @param start The index of the start vertex.
+         * @param end The index of the end vertex.
+         * @param landmarks The landmark index of the graph.
+         * @param result Filled with the status, the distance and the path.
+         */
+        static void landmarkShortestPath(const Graph& graph, size_t start, size_t end, const LandmarkIndex& landmarks, PathResult& result);
+
+
+        /**
+         * @brief This auxiliary function finds the shortest path between two vertices using a parallel delta-stepping search.
+         *
+         * The tentative distances are kept in buckets of width delta (the largest weight over the average degree). The vertices of
+         * the first non-empty bucket are split between the threads, which relax all their edges with an atomic minimum on the
+         * distances and put the improved vertices in their own buckets; a bucket is scanned again until no edge refills it. The
+         * search stops once the buckets left start after the distance to end, and the path is rebuilt by buildBidirectionalPath
+         * (the same path as a forward Dijkstra's search).
+         *
+         * @param graph The graph (with positive weights only).
+         * @param start The index of the start vertex.
+         * @param end The index of the end vertex.
+         * @param result Filled with the status, the distance and the path.
+         */
+        static void deltaSteppingShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result);
+
+
+        /**
+         * @brief This auxiliary function computes the distances from a vertex using a parallel delta-stepping search.
+         *
+         * The tentative distances are kept in buckets of width delta (the largest weight over the average degree). The vertices of
+         * the first non-empty bucket are split between the threads, which relax all their edges with an atomic minimum on the
+         * distances and put the improved vertices in their own buckets; a bucket is scanned again until no edge refills it. The
+         * search stops once the buckets left start after the distance to end, or once they are all empty.
+         *
+         * @param graph The graph (with positive weights only).
+         * @param start The index of the start vertex.
+         * @param end The index of the end vertex (pass a value >= the number of vertices to search the whole graph).
+         * @param distance Filled with the tentative distance of every vertex (LLONG_MAX for vertices that were not reached).
+         * @return The bound below which the distances are final (LLONG_MAX if the whole graph was searched).
+         */
+        static long long deltaSteppingDistances(const Graph& graph, size_t start, size_t end, vector<long long>& distance);
+
+
+        /**
+         * @brief This auxiliary function finds the shortest path between two vertices with the contraction hierarchy of the graph.
+         *
+         * The distance is found by a bidirectional upward search, and the path is the one a forward Dijkstra's search returns
+         * (see ContractionHierarchy::path).
+         *
+         * @param graph The graph (with non-negative weights only).
+         * @param start The index of the start vertex.
+         * @param end The index of the end vertex.
+         * @param hierarchy The contraction hierarchy of the graph.
+         * @param result Filled with the status, the distance and the path.
+         */
+        static void contractionHierarchyShortestPath(const Graph& graph, size_t start, size_t end, const ContractionHierarchy& hierarchy, PathResult& result);
+
+
+        /**
+         * @brief This auxiliary function finds the shortest path between two vertices using Dial's algorithm (a bucket queue).
+         *
+         * Vertices wait in a circular array of maxWeight + 1 buckets indexed by distance. Since every weight is between 1 and
+         * maxWeight, the bucket of the current distance is complete when it is reached; it is sorted so that vertices with
+         * equal distances are settled by index, as in the other Dijkstra versions. Time complexity: O(|E| + |V|*maxWeight).
+         *
+         * @param graph The graph (with positive weights only).
+         * @param start The index of the start vertex.
+         * @param end The index of the end vertex.
+         * @param maxWeight The largest edge weight of the graph.
+         * @param result Filled with the status, the distance and the path.
+         */
+        static void dialShortestPath(const Graph& graph, size_t start, size_t end, int maxWeight, PathResult& result);
+
+
+        /**
+         * @brief This auxiliary function finds the shortest path between two vertices using Dijkstra's algorithm with a radix heap.
+         *
+         * A key waits in the bucket of the highest bit in which it differs from the last extracted key, so every key moves
+         * down at most 64 times. All keys equal to the last extracted key are settled together, sorted by index, as in the
+         * other Dijkstra versions. Time complexity: O(|E| + |V|*log(C)) where C is the largest weight.
+         *
+         * @param graph The graph (with positive weights only).
+         * @param start The index of the start vertex.
+         * @param end The index of the end vertex.
+         * @param result Filled with the status, the distance and the path.
+         */
+        static void radixHeapShortestPath(const Graph& graph, size_t start, size_t end, PathResult& result);
         
 
         /**
          * @brief This auxiliary function finds the vertex with the minimum distance that has not been visited yet.
          * 
          * This is a function used by Dijkstra's algorithm to select the next vertex to visit.
+         * With SSE2 it first finds the minimum four lanes at a time and then the first vertex that holds it.
          *
-         * @param distance A vector of distances from the start vertex.
-         * @param visited A vector indicating whether each vertex has been visited.
-         * @return The index of the vertex with the smallest distance that has not been visited.
+         * @param key The distance of every unvisited vertex from the start vertex (INT_MAX for visited vertices).
+         * @return The smallest index of a vertex with the smallest distance, or SIZE_MAX if every key is INT_MAX.
          */
-        static size_t findMinDistanceVertex(vector<int>& distance, vector<bool>& visited);
+        static size_t findMinDistanceVertex(const vector<int>& key);
+
+
+        /**
+         * @brief This auxiliary function relaxes all the edges leaving a vertex, given the row of the vertex in a dense matrix.
+         *
+         * With SSE2 four edges are relaxed at a time (sums that overflow an int are ignored). The weights must be non-negative,
+         * so already visited vertices are never improved.
+         *
+         * @param row The weights of the edges leaving vertex_u (0 means no edge).
+         * @param vertex_u The vertex whose edges are relaxed.
+         * @param distance The vector storing the distances from the start vertex to each vertex.
+         * @param key The distances of the unvisited vertices, updated together with distance.
+         * @param parent The vector storing the parent of each vertex in the shortest path tree.
+         */
+        static void relaxDenseRow(const int* row, size_t vertex_u, vector<int>& distance, vector<int>& key, vector<size_t>& parent);
 
 
         /**
@@ -194,23 +653,25 @@ class Algorithms {
          * @param start The start vertex of the path.
          * @param end The end vertex of the path.
          * @param parent The vector containing each vertex's parent in the path.
-         * @return A string representing the path or an empty string if no path exists.
+         * @param path Filled with the vertices of the path from start to end, or cleared if no path exists.
          */
-        static string buildPath(size_t start, size_t end, vector<size_t>& parent);
+        static void buildPath(size_t start, size_t end, const vector<size_t>& parent, vector<size_t>& path);
 
         
         /**
          * @brief This auxiliary function uses DFS to detect a cycle in the graph starting from a given vertex.
      
-        * @param graph The graph to be checked.
+        * @param edges The edges of the graph to be checked (sorted by target, so the neighbours are visited in index order).
         * @param vertex The current vertex that explored in the DFS.
         * @param visited A vector that tracks if each vertex already visited to avoid revisiting.
         * @param recStack A vector that tracks "active" vertices in the current recursion to find cycles.
         * @param parent A vector that stores the parent of each vertex, for building the circle (if found).
         * @param isDirected Boolean that give an undication if the graph is directed; that affects finding of back edges.
-        * @return A string representing the cycle, or an empty string if no cycle is found.
+        * @param cycle Filled with the vertices of the cycle, if one is found.
+        * @return true if a cycle is found; otherwise, false.
         */
-        static string dfs_cycle(Graph& graph, size_t vertex, vector<bool>& visited, vector<bool>& recStack, vector<size_t>& parent, bool isDirected);
+        static bool dfs_cycle(const AdjacencyIndex& edges, size_t vertex, vector<bool>& visited, vector<bool>& recStack, vector<size_t>& parent, bool isDirected,
+                              vector<size_t>& cycle);
             
 
         /**
@@ -219,13 +680,14 @@ class Algorithms {
          * A graph is bipartite if it can be colored using two colors such that no two adjacent vertices
          * share the same color.
          *
-         * @param graph The graph to check.
+         * @param outEdges The edges of the graph to check.
+         * @param inEdges The reversed edges of the graph, so edges are followed in both directions.
          * @param currectVertex The vertex to start coloring.
          * @param colorVec A vector storing the color of each vertex, initialized to -1 (uncolored).
          * @param color The current color to use (0 or 1).
          * @return true if the graph can be colored bipartitely; otherwise, false.
          */
-        static bool dfsCheck(Graph& graph, size_t currectVertex, vector<int>& colorVec, int color);
+        static bool dfsCheck(const AdjacencyIndex& outEdges, const AdjacencyIndex& inEdges, size_t currectVertex, vector<int>& colorVec, int color);
         
         
         /**
@@ -243,40 +705,51 @@ class Algorithms {
          * @param graph The graph to be checked.
          * @return A pair of boolean values the give indication if the graph is unweighted and if it has negative edges.
          */
-        static pair<bool, bool> checkGraphType(Graph& graph);
+        static pair<bool, bool> checkGraphType(const Graph& graph);
 
 
         /**
-         * @brief This auxiliary function finds a negative cycle (if exists) in a graph using a Bellman-Ford algorithm.
-         * 
-         * This function attempts to detect a negative cycle by relaxing edges repeatedly and try to find an indication for a cycle.
+         * @brief This auxiliary function computes the shortest paths between all pairs of vertices of a sparse graph with Johnson's algorithm.
          *
-         * @param graph The graph in which to detect negative cycles.
-         * @return A string describing the cycle if found, or a message indicating no cycle exists.
+         * If some weights are negative, the distances from a virtual source joined to every vertex (found by the same subtree
+         * disassembly as negativeCycle, but relaxing the edges back to the parent as well) are used as potentials p, and every
+         * weight w(u,v) becomes w(u,v) + p(u) - p(v) >= 0. Then a Dijkstra's search with a binary heap runs from every vertex;
+         * the sources are split between the threads (see Parallel). Time complexity: O(|V|*|E|*log|V|).
+         *
+         * @param graph The graph.
+         * @return The distance and the next hop between every pair of vertices, or an indication of a negative cycle.
          */
-        static string findNegativeCircle(Graph& graph);
+        static AllPairsShortestPaths johnsonShortestPaths(const Graph& graph);
 
 
         /**
-         * @brief This auxiliary function finds a vertex in a negative cycle.
+         * @brief This auxiliary function finds a negative cycle (if exists) in a graph using Tarjan's subtree disassembly.
+         * 
+         * A queue-based Bellman-Ford runs from a virtual source joined to every vertex by a 0 edge, and keeps its shortest path
+         * tree as a list in preorder. When u->v is relaxed, the subtree of v is removed from the tree (the distances in it are
+         * out of date, so its vertices are not scanned until they improve again); if u is in that subtree, the tree path
+         * v->...->u and the edge u->v close a negative cycle, which is reported at once. As in the shortest path search, an
+         * edge u->v is not relaxed when v is the parent of u (unless backtrack is set), so an undirected edge is not taken as
+         * a cycle.
          *
-         * @param graph The graph.
-         * @param distance The vector storing the distances from the source vertex to each vertex.
-         * @param parent The vector storing the parent of each vertex in the shortest path tree.
-         * @return The vertex in the negative cycle.
+         * @param graph The graph in which to detect negative cycles.
+         * @param backtrack true to relax the edges back to the parent as well (then the distances are feasible potentials).
+         * @param distance Filled with the distance of every vertex from the virtual source, if no cycle is found.
+         * @param cycle Filled with the vertices of the cycle, if one is found.
+         * @return true if a negative cycle was found; otherwise, false.
          */
-        static size_t findNegativeCycleVertex(Graph& graph, vector<int>& distance, vector<size_t>& parent);
+        static bool findNegativeCircle(const Graph& graph, bool backtrack, vector<long long>& distance, vector<size_t>& cycle);
 
 
         /**
-         * @brief This auxiliary function builds a negative cycle found in the graph.
+         * @brief This auxiliary function builds the negative cycle path.
          *
-         * @param graph The graph containing the negative cycle.
-         * @param distance The vector storing the distances from the source vertex to each vertex.
+         * @param vertex_v The first vertex of the cycle.
+         * @param vertex_u The last vertex of the cycle before returning to vertex_v (a descendant of vertex_v in the tree).
          * @param parent The vector storing the parent of each vertex in the shortest path tree.
-         * @return A string representing the negative cycle.
+         * @param cycle Filled with the vertices of the cycle, v->...->u->v.
          */
-        static string buildNegativeCycle(Graph& graph, size_t vertex_v, vector<size_t>& parent);
+        static void buildNegativeCycle(size_t vertex_v, size_t vertex_u, const vector<size_t>& parent, vector<size_t>& cycle);
 
     };
     
@@ -0,0 +1,756 @@
+// Email: origoldbsc@gmail.com
+
+#include "ContractionHierarchy.hpp"
+#include <stdexcept>
+#include <climits>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+
+namespace ariel {
+
+    namespace {
+
+        const size_t WITNESS_SETTLE_LIMIT = 500;        // Witness searches give up (and add the shortcut) after this many vertices
+        const size_t ESTIMATE_SETTLE_LIMIT = 50;        // The same limit when only the priority of a vertex is estimated
+        const char HIERARCHY_MAGIC[8] = {'A', 'R', 'C', 'H', 'I', 'E', 'R', '\0'};     // Identifies a hierarchy file
+        const uint32_t HIERARCHY_VERSION = 1;           // The current version of the format
+
+        /**
+         * @brief The header at the beginning of every hierarchy file, followed by the upward and the downward arcs
+         * (uint64 offsets[V+1], uint32 vertices[N], int64 weights[N] each). Fields are stored in host byte order.
+         */
+        struct HierarchyHeader
+        {
+            char magic[8];              // HIERARCHY_MAGIC
+            uint32_t version;           // HIERARCHY_VERSION
+            uint32_t flags;             // Reserved (0)
+            uint64_t numVertices;       // The number of vertices
+            uint64_t numShortcuts;      // The number of shortcuts added by the contraction
+            uint64_t fingerprint;       // A hash of the edges of the indexed graph
+            uint64_t numUpArcs;         // The number of upward arcs
+            uint64_t numDownArcs;       // The number of downward arcs
+            uint64_t reserved;          // Pads the header to 64 bytes
+        };
+
+        static_assert(sizeof(HierarchyHeader) == 64, "The hierarchy header must be 64 bytes long");
+
+
+        /**
+         * @brief An arc of the graph that remains while vertices are contracted.
+         */
+        struct Arc
+        {
+            size_t vertex;              // The other end of the arc
+            long long weight;           // The length of the arc
+        };
+
+
+        /**
+         * @brief This auxiliary function hashes the edges of a graph (FNV-1a), so a hierarchy can be matched to its graph.
+         *
+         * @param graph The graph.
+         * @return The hash.
+         */
+        uint64_t fingerprintOf(const Graph& graph)
+        {
+            const AdjacencyIndex& edges = graph.getOutEdges();
+            uint64_t hash = 14695981039346656037ULL;
+            auto mix = [&hash](uint64_t value)
+            {
+                hash = (hash ^ value) * 1099511628211ULL;
+            };
+
+            mix(graph.getNumVertices());
+            for (size_t u = 0; u < edges.numVertices; u++)
+            {
+                mix(edges.offsets[u + 1] - edges.offsets[u]);
+                for (size_t e = edges.offsets[u]; e < edges.offsets[u + 1]; e++)
+                {
+                    mix(edges.targets[e]);
+                    mix(static_cast<uint64_t>(static_cast<uint32_t>(edges.weights[e])));
+                }
+            }
+            return hash;
+        }
+
+
+        /**
+         * @brief This auxiliary class holds the arcs between the vertices that are not contracted yet, and contracts them.
+         */
+        class Contractor
+        {
+            private:
+                vector<vector<Arc>> _out;           // The remaining arcs leaving each vertex
+                vector<vector<Arc>> _in;            // The remaining arcs entering each vertex
+                vector<long long> _witness;         // Tentative distances of the current witness search (LLONG_MAX when untouched)
+                vector<size_t> _touched;            // The vertices whose witness distance was set
+
+            public:
+                explicit Contractor(const AdjacencyIndex& edges) : _out(edges.numVertices), _in(edges.numVertices), _witness(edges.numVertices, LLONG_MAX)
+                {
+                    for (size_t u = 0; u < edges.numVertices; u++)
+                    {
+                        for (size_t e = edges.offsets[u]; e < edges.offsets[u + 1]; e++)
+                        {
+                            size_t v = edges.targets[e];
+                            if (v != u)
+                            {
+                                _out[u].push_back(Arc{v, edges.weights[e]});
+                                _in[v].push_back(Arc{u, edges.weights[e]});
+                            }
+                        }
+                    }
+                }
+
+                const vector<Arc>& outArcs(size_t vertex) const
+                {
+                    return _out[vertex];
+                }
+
+                const vector<Arc>& inArcs(size_t vertex) const
+                {
+                    return _in[vertex];
+                }
+
+                /**
+                 * @brief Counts (and if apply is set, adds) the shortcuts needed to contract a vertex.
+                 */
+                size_t contract(size_t vertex, bool apply)
+                {
+                    size_t numShortcuts = 0;
+                    for (size_t i = 0; i < _in[vertex].size(); i++)
+                    {
+                        size_t source = _in[vertex][i].vertex;
+                        long long toVertex = _in[vertex][i].weight;
+
+                        // Witnesses longer than the longest path through vertex are useless
+                        long long limit = -1;
+                        for (size_t j = 0; j < _out[vertex].size(); j++)
+                        {
+                            if (_out[vertex][j].vertex != source)
+                            {
+                                limit = max(limit, toVertex + _out[vertex][j].weight);
+                            }
+                        }
+                        if (limit < 0)
+                        {
+                            continue;
+                        }
+
+                        witnessSearch(source, vertex, limit, apply ? WITNESS_SETTLE_LIMIT : ESTIMATE_SETTLE_LIMIT);
+                        for (size_t j = 0; j < _out[vertex].size(); j++)
+                        {
+                            size_t target = _out[vertex][j].vertex;
+                            long long through = toVertex + _out[vertex][j].weight;
+                            if (target != source && _witness[target] > through)
+                            {
+                                numShortcuts++;
+                                if (apply)
+                                {
+                                    addArc(source, target, through);
+                                }
+                            }
+                        }
+                        for (size_t j = 0; j < _touched.size(); j++)
+                        {
+                            _witness[_touched[j]] = LLONG_MAX;
+                        }
+                        _touched.clear();
+                    }
+                    return numShortcuts;
+                }
+
+                /**
+                 * @brief Removes a contracted vertex from the arc lists of its neighbours.
+                 */
+                void remove(size_t vertex)
+                {
+                    for (size_t i = 0; i < _out[vertex].size(); i++)
+                    {
+                        eraseArc(_in[_out[vertex][i].vertex], vertex);
+                    }
+                    for (size_t i = 0; i < _in[vertex].size(); i++)
+                    {
+                        eraseArc(_out[_in[vertex][i].vertex], vertex);
+                    }
+                    vector<Arc>().swap(_out[vertex]);
+                    vector<Arc>().swap(_in[vertex]);
+                }
+
+            private:
+                void witnessSearch(size_t source, size_t excluded, long long limit, size_t settleLimit)
+                {
+                    typedef pair<long long, size_t> Entry;
+                    priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+                    size_t numSettled = 0;
+                    _witness[source] = 0;
+                    _touched.push_back(source);
+                    heap.push(make_pair(0LL, source));
+
+                    while (!heap.empty() && heap.top().first <= limit && numSettled < settleLimit)
+                    {
+                        Entry top = heap.top();
+                        heap.pop();
+                        size_t vertex_u = top.second;
+                        if (top.first != _witness[vertex_u])
+                        {
+                            continue;       // A stale entry
+                        }
+                        numSettled++;
+                        for (size_t i = 0; i < _out[vertex_u].size(); i++)
+                        {
+                            size_t vertex_v = _out[vertex_u][i].vertex;
+                            long long candidate = top.first + _out[vertex_u][i].weight;
+                            if (vertex_v != excluded && candidate < _witness[vertex_v])
+                            {
+                                if (_witness[vertex_v] == LLONG_MAX)
+                                {
+                                    _touched.push_back(vertex_v);
+                                }
+                                _witness[vertex_v] = candidate;
+                                heap.push(make_pair(candidate, vertex_v));
+                            }
+                        }
+                    }
+                }
+
+                void addArc(size_t source, size_t target, long long weight)
+                {
+                    for (size_t i = 0; i < _out[source].size(); i++)
+                    {
+                        if (_out[source][i].vertex == target)
+                        {
+                            // Replace a longer parallel arc
+                            _out[source][i].weight = min(_out[source][i].weight, weight);
+                            for (size_t j = 0; j < _in[target].size(); j++)
+                            {
+                                if (_in[target][j].vertex == source)
+                                {
+                                    _in[target][j].weight = _out[source][i].weight;
+                                }
+                            }
+                            return;
+                        }
+                    }
+                    _out[source].push_back(Arc{target, weight});
+                    _in[target].push_back(Arc{source, weight});
+                }
+
+                static void eraseArc(vector<Arc>& arcs, size_t vertex)
+                {
+                    for (size_t i = 0; i < arcs.size(); i++)
+                    {
+                        if (arcs[i].vertex == vertex)
+                        {
+                            arcs[i] = arcs.back();
+                            arcs.pop_back();
+                            return;
+                        }
+                    }
+                }
+        };
+
+
+        /**
+         * @brief This auxiliary function checks if an upward search can stall a vertex (stall-on-demand).
+         *
+         * @param vertex The vertex that is about to be expanded.
+         * @param distance Its tentative distance.
+         * @param offsets The arcs between the vertex and more important vertices, in the opposite direction of the search.
+         * @param vertices The other ends of the arcs.
+         * @param weights The lengths of the arcs.
+         * @param tentative The tentative distances of the search.
+         * @return true if a more important vertex reaches the vertex more cheaply; otherwise, false.
+         */
+        bool isStalled(size_t vertex, long long distance, const vector<size_t>& offsets, const vector<uint32_t>& vertices,
+                       const vector<long long>& weights, const unordered_map<size_t, long long>& tentative)
+        {
+            for (size_t e = offsets[vertex]; e < offsets[vertex + 1]; e++)
+            {
+                unordered_map<size_t, long long>::const_iterator found = tentative.find(vertices[e]);
+                if (found != tentative.end() && found->second + weights[e] < distance)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+
+        /**
+         * @brief This auxiliary function stores lists of arcs in CSR form.
+         *
+         * @param arcs The arcs of every vertex.
+         * @param offsets Set to the offsets of the arcs of every vertex.
+         * @param vertices Set to the other ends of the arcs.
+         * @param weights Set to the lengths of the arcs.
+         */
+        void compress(const vector<vector<Arc>>& arcs, vector<size_t>& offsets, vector<uint32_t>& vertices, vector<long long>& weights)
+        {
+            offsets.assign(arcs.size() + 1, 0);
+            for (size_t v = 0; v < arcs.size(); v++)
+            {
+                offsets[v + 1] = offsets[v] + arcs[v].size();
+            }
+            vertices.resize(offsets.back());
+            weights.resize(offsets.back());
+            for (size_t v = 0; v < arcs.size(); v++)
+            {
+                for (size_t i = 0; i < arcs[v].size(); i++)
+                {
+                    vertices[offsets[v] + i] = static_cast<uint32_t>(arcs[v][i].vertex);
+                    weights[offsets[v] + i] = arcs[v][i].weight;
+                }
+            }
+        }
+
+
+        /**
+         * @brief This auxiliary function checks that arcs loaded from a file are consistent.
+         *
+         * @return true if the offsets are monotone and end at the number of arcs, and every vertex is valid; otherwise, false.
+         */
+        bool validArcs(const vector<size_t>& offsets, const vector<uint32_t>& vertices, const vector<long long>& weights, size_t numVertices)
+        {
+            if (offsets.front() != 0 || offsets.back() != vertices.size())
+            {
+                return false;
+            }
+            for (size_t v = 0; v < numVertices; v++)
+            {
+                if (offsets[v] > offsets[v + 1])
+                {
+                    return false;
+                }
+            }
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                if (vertices[i] >= numVertices || weights[i] < 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+
+    /**
+     * @brief A default constructor for the ContractionHierarchy class (an index of no vertices).
+     */
+    ContractionHierarchy::ContractionHierarchy() : _numVertices(0), _numShortcuts(0), _fingerprint(0), _upOffsets(1, 0), _downOffsets(1, 0)
+    {
+    }
+
+
+    /**
+     * @brief This method contracts a graph and builds its hierarchy.
+     *
+     * The next vertex to contract is the one with the smallest edge difference (shortcuts added minus arcs removed) plus
+     * number of contracted neighbours, with lazy updates. Witness searches are bounded, so a few redundant shortcuts
+     * may be added. Building takes minutes on graphs with millions of vertices.
+     *
+     * @param graph The graph.
+     * @return The hierarchy.
+     * @throws If the graph has negative weights throw invalid_argument exception
+     */
+    ContractionHierarchy ContractionHierarchy::build(const Graph& graph)
+    {
+        if (graph.getMinWeight() < 0)
+        {
+            throw invalid_argument("Invalid graph: Contraction hierarchies require non-negative weights");
+        }
+
+        size_t numVertices = graph.getNumVertices();
+        Contractor contractor(graph.getOutEdges());
+        vector<size_t> contractedNeighbours(numVertices, 0);
+        vector<char> contracted(numVertices, 0);
+        vector<long long> priority(numVertices);
+        vector<vector<Arc>> upArcs(numVertices);       // The arcs of each vertex to vertices contracted after it
+        vector<vector<Arc>> downArcs(numVertices);
+
+        ContractionHierarchy hierarchy;
+        hierarchy._numVertices = numVertices;
+        hierarchy._fingerprint = fingerprintOf(graph);
+
+        // The priority of a vertex: the edge difference of contracting it, plus its contracted neighbours (spreads the contraction)
+        auto importance = [&contractor, &contractedNeighbours](size_t vertex)
+        {
+            size_t removed = contractor.outArcs(vertex).size() + contractor.inArcs(vertex).size();
+            return static_cast<long long>(contractor.contract(vertex, false)) - static_cast<long long>(removed) +
+                   static_cast<long long>(contractedNeighbours[vertex]);
+        };
+
+        typedef pair<long long, size_t> Entry;
+        priority_queue<Entry, vector<Entry>, greater<Entry>> queue;
+        for (size_t v = 0; v < numVertices; v++)
+        {
+            priority[v] = importance(v);
+            queue.push(make_pair(priority[v], v));
+        }
+
+        vector<size_t> neighbours;
+        while (!queue.empty())
+        {
+            Entry top = queue.top();
+            queue.pop();
+            size_t vertex = top.second;
+            if (contracted[vertex] || top.first != priority[vertex])
+            {
+                continue;       // A stale entry
+            }
+
+            // Lazy update: the priority may have grown since it was computed
+            long long current = importance(vertex);
+            if (current != priority[vertex] && !queue.empty() && current > queue.top().first)
+            {
+                priority[vertex] = current;
+                queue.push(make_pair(current, vertex));
+                continue;
+            }
+
+            hierarchy._numShortcuts += contractor.contract(vertex, true);
+            upArcs[vertex] = contractor.outArcs(vertex);
+            downArcs[vertex] = contractor.inArcs(vertex);
+
+            neighbours.clear();
+            for (size_t i = 0; i < upArcs[vertex].size(); i++)
+            {
+                neighbours.push_back(upArcs[vertex][i].vertex);
+            }
+            for (size_t i = 0; i < downArcs[vertex].size(); i++)
+            {
+                neighbours.push_back(downArcs[vertex][i].vertex);
+            }
+            sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+            contractor.remove(vertex);
+            contracted[vertex] = 1;
+            for (size_t i = 0; i < neighbours.size(); i++)
+            {
+                contractedNeighbours[neighbours[i]]++;
+            }
+        }
+
+        compress(upArcs, hierarchy._upOffsets, hierarchy._upTargets, hierarchy._upWeights);
+        compress(downArcs, hierarchy._downOffsets, hierarchy._downSources, hierarchy._downWeights);
+        return hierarchy;
+    }
+
+
+    /**
+     * @brief This method saves the hierarchy to a binary file.
+     *
+     * @param path The path of the file.
+     * @throws If the file cannot be written throw runtime_error exception
+     */
+    void ContractionHierarchy::save(const string& path) const
+    {
+        ofstream file(path.c_str(), ios::binary | ios::trunc);
+        if (!file)
+        {
+            throw runtime_error("Cannot open " + path + " for writing");
+        }
+
+        HierarchyHeader header = HierarchyHeader();
+        copy(HIERARCHY_MAGIC, HIERARCHY_MAGIC + 8, header.magic);
+        header.version = HIERARCHY_VERSION;
+        header.numVertices = (*this)._numVertices;
+        header.numShortcuts = (*this)._numShortcuts;
+        header.fingerprint = (*this)._fingerprint;
+        header.numUpArcs = (*this)._upTargets.size();
+        header.numDownArcs = (*this)._downSources.size();
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>((*this)._upOffsets.data()), static_cast<streamsize>((*this)._upOffsets.size() * sizeof(size_t)));
+        file.write(reinterpret_cast<const char*>((*this)._upTargets.data()), static_cast<streamsize>((*this)._upTargets.size() * sizeof(uint32_t)));
+        file.write(reinterpret_cast<const char*>((*this)._upWeights.data()), static_cast<streamsize>((*this)._upWeights.size() * sizeof(long long)));
+        file.write(reinterpret_cast<const char*>((*this)._downOffsets.data()), static_cast<streamsize>((*this)._downOffsets.size() * sizeof(size_t)));
+        file.write(reinterpret_cast<const char*>((*this)._downSources.data()), static_cast<streamsize>((*this)._downSources.size() * sizeof(uint32_t)));
+        file.write(reinterpret_cast<const char*>((*this)._downWeights.data()), static_cast<streamsize>((*this)._downWeights.size() * sizeof(long long)));
+        file.close();
+        if (!file)
+        {
+            throw runtime_error("Cannot save contraction hierarchy to " + path);
+        }
+    }
+
+
+    /**
+     * @brief This method loads a hierarchy saved by save().
+     *
+     * @param path The path of the file.
+     * @return The hierarchy stored in the file.
+     * @throws If the file cannot be read throw runtime_error exception, if it is not a valid hierarchy file throw
+     * invalid_argument exception
+     */
+    ContractionHierarchy ContractionHierarchy::load(const string& path)
+    {
+        ifstream file(path.c_str(), ios::binary);
+        if (!file)
+        {
+            throw runtime_error("Cannot open " + path);
+        }
+
+        // Check the header against the actual size of the file before allocating anything
+        file.seekg(0, ios::end);
+        uint64_t length = static_cast<uint64_t>(file.tellg());
+        file.seekg(0, ios::beg);
+        HierarchyHeader header;
+        if (length < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            !equal(HIERARCHY_MAGIC, HIERARCHY_MAGIC + 8, header.magic) || header.version != HIERARCHY_VERSION ||
+            header.numVertices > UINT32_MAX || header.numUpArcs > length || header.numDownArcs > length ||
+            length != sizeof(header) + (2 * header.numVertices + 2) * sizeof(size_t) +
+                      (header.numUpArcs + header.numDownArcs) * (sizeof(uint32_t) + sizeof(long long)))
+        {
+            throw invalid_argument("Invalid contraction hierarchy file: " + path);
+        }
+
+        ContractionHierarchy hierarchy;
+        hierarchy._numVertices = header.numVertices;
+        hierarchy._numShortcuts = header.numShortcuts;
+        hierarchy._fingerprint = header.fingerprint;
+        hierarchy._upOffsets.resize(header.numVertices + 1);
+        hierarchy._upTargets.resize(header.numUpArcs);
+        hierarchy._upWeights.resize(header.numUpArcs);
+        hierarchy._downOffsets.resize(header.numVertices + 1);
+        hierarchy._downSources.resize(header.numDownArcs);
+        hierarchy._downWeights.resize(header.numDownArcs);
+
+        file.read(reinterpret_cast<char*>(hierarchy._upOffsets.data()), static_cast<streamsize>(hierarchy._upOffsets.size() * sizeof(size_t)));
+        file.read(reinterpret_cast<char*>(hierarchy._upTargets.data()), static_cast<streamsize>(hierarchy._upTargets.size() * sizeof(uint32_t)));
+        file.read(reinterpret_cast<char*>(hierarchy._upWeights.data()), static_cast<streamsize>(hierarchy._upWeights.size() * sizeof(long long)));
+        file.read(reinterpret_cast<char*>(hierarchy._downOffsets.data()), static_cast<streamsize>(hierarchy._downOffsets.size() * sizeof(size_t)));
+        file.read(reinterpret_cast<char*>(hierarchy._downSources.data()), static_cast<streamsize>(hierarchy._downSources.size() * sizeof(uint32_t)));
+        file.read(reinterpret_cast<char*>(hierarchy._downWeights.data()), static_cast<streamsize>(hierarchy._downWeights.size() * sizeof(long long)));
+        if (!file)
+        {
+            throw runtime_error("Cannot read " + path);
+        }
+
+        if (!validArcs(hierarchy._upOffsets, hierarchy._upTargets, hierarchy._upWeights, hierarchy._numVertices) ||
+            !validArcs(hierarchy._downOffsets, hierarchy._downSources, hierarchy._downWeights, hierarchy._numVertices))
+        {
+            throw invalid_argument("Invalid contraction hierarchy file: " + path);
+        }
+        return hierarchy;
+    }
+
+
+    /**
+     * @brief This method checks if the hierarchy was built for a graph (same vertices, edges and weights).
+     * @param graph The graph.
+     * @return true if the hierarchy belongs to the graph; otherwise, false.
+     */
+    bool ContractionHierarchy::matches(const Graph& graph) const
+    {
+        return graph.getNumVertices() == (*this)._numVertices && fingerprintOf(graph) == (*this)._fingerprint;
+    }
+
+
+    /**
+     * @brief This method returns the number of vertices of the indexed graph.
+     * @return The number of vertices.
+     */
+    size_t ContractionHierarchy::getNumVertices() const
+    {
+        return (*this)._numVertices;
+    }
+
+
+    /**
+     * @brief This method returns the number of shortcuts added by the contraction.
+     * @return The number of shortcuts.
+     */
+    size_t ContractionHierarchy::getNumShortcuts() const
+    {
+        return (*this)._numShortcuts;
+    }
+
+
+    /**
+     * @brief This auxiliary function runs a full upward search from a vertex.
+     *
+     * Vertices that are reached more cheaply through a more important vertex are stalled (not expanded), since their
+     * distance is not exact and no shortest path goes up through them.
+     *
+     * @param source The vertex to start from.
+     * @param distance Filled with the settled vertices and their distances, sorted by vertex (cleared first).
+     */
+    void ContractionHierarchy::upwardSearch(size_t source, vector<pair<size_t, long long>>& distance) const
+    {
+        // Upward search spaces are small, so the tentative distances live in a hash map instead of a |V|-sized array
+        typedef pair<long long, size_t> Entry;
+        priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+        unordered_map<size_t, long long> tentative;
+        distance.clear();
+        tentative[source] = 0;
+        heap.push(make_pair(0LL, source));
+
+        while (!heap.empty())
+        {
+            Entry top = heap.top();
+            heap.pop();
+            size_t vertex_u = top.second;
+            if (top.first != tentative[vertex_u] || isStalled(vertex_u, top.first, (*this)._downOffsets, (*this)._downSources, (*this)._downWeights, tentative))
+            {
+                continue;       // A stale or stalled entry
+            }
+            distance.push_back(make_pair(vertex_u, top.first));
+            for (size_t e = (*this)._upOffsets[vertex_u]; e < (*this)._upOffsets[vertex_u + 1]; e++)
+            {
+                size_t vertex_v = (*this)._upTargets[e];
+                long long candidate = top.first + (*this)._upWeights[e];
+                unordered_map<size_t, long long>::iterator found = tentative.find(vertex_v);
+                if (found == tentative.end() || candidate < found->second)
+                {
+                    tentative[vertex_v] = candidate;
+                    heap.push(make_pair(candidate, vertex_v));
+                }
+            }
+        }
+        sort(distance.begin(), distance.end());
+    }
+
+
+    /**
+     * @brief This auxiliary function checks if the distance between two vertices is at most a bound.
+     *
+     * @param forwardSpace The sorted result of the forward upward search from the first vertex.
+     * @param target The second vertex.
+     * @param bound The bound.
+     * @return The distance if it is at most the bound, otherwise LLONG_MAX.
+     */
+    long long ContractionHierarchy::boundedDistance(const vector<pair<size_t, long long>>& forwardSpace, size_t target, long long bound) const
+    {
+        typedef pair<long long, size_t> Entry;
+        priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+        unordered_map<size_t, long long> tentative;
+        long long best = LLONG_MAX;
+        tentative[target] = 0;
+        heap.push(make_pair(0LL, target));
+
+        // Forward distances are non-negative, so keys beyond the bound or the best meeting cannot improve it
+        while (!heap.empty() && heap.top().first <= bound && heap.top().first < best)
+        {
+            Entry top = heap.top();
+            heap.pop();
+            size_t vertex_u = top.second;
+            if (top.first != tentative[vertex_u] || isStalled(vertex_u, top.first, (*this)._upOffsets, (*this)._upTargets, (*this)._upWeights, tentative))
+            {
+                continue;       // A stale or stalled entry
+            }
+
+            vector<pair<size_t, long long>>::const_iterator meeting =
+                lower_bound(forwardSpace.begin(), forwardSpace.end(), make_pair(vertex_u, LLONG_MIN));
+            if (meeting != forwardSpace.end() && meeting->first == vertex_u)
+            {
+                best = min(best, meeting->second + top.first);
+            }
+
+            for (size_t e = (*this)._downOffsets[vertex_u]; e < (*this)._downOffsets[vertex_u + 1]; e++)
+            {
+                size_t vertex_v = (*this)._downSources[e];
+                long long candidate = top.first + (*this)._downWeights[e];
+                unordered_map<size_t, long long>::iterator found = tentative.find(vertex_v);
+                if (candidate <= bound && (found == tentative.end() || candidate < found->second))
+                {
+                    tentative[vertex_v] = candidate;
+                    heap.push(make_pair(candidate, vertex_v));
+                }
+            }
+        }
+        return best <= bound ? best : LLONG_MAX;
+    }
+
+
+    /**
+     * @brief This method finds the distance between two vertices with a bidirectional upward search.
+     *
+     * @param start The start vertex.
+     * @param end The end vertex.
+     * @return The distance, or LLONG_MAX if end is unreachable from start.
+     * @throws If a vertex is invalid throw invalid_argument exception
+     */
+    long long ContractionHierarchy::distance(size_t start, size_t end) const
+    {
+        if (start >= (*this)._numVertices || end >= (*this)._numVertices)
+        {
+            throw invalid_argument("Invalid start or end vertex");
+        }
+
+        vector<pair<size_t, long long>> forwardSpace;
+        upwardSearch(start, forwardSpace);
+        return boundedDistance(forwardSpace, end, LLONG_MAX - 1);
+    }
+
+
+    /**
+     * @brief This method finds the shortest path between two vertices.
+     *
+     * The path is the one a forward Dijkstra's search returns: walking back from end, the parent of each vertex is its
+     * in-neighbour on a shortest path with the smallest (distance from start, index). Candidates are checked in that
+     * order with upward searches that are cut off at the required distance.
+     *
+     * @param graph The indexed graph (its in-edges are used to walk back from end).
+     * @param start The start vertex.
+     * @param end The end vertex.
+     * @return The vertices of the path from start to end, or an empty vector if end is unreachable from start.
+     * @throws If a vertex is invalid or the graph has a different number of vertices throw invalid_argument exception
+     */
+    vector<size_t> ContractionHierarchy::path(const Graph& graph, size_t start, size_t end) const
+    {
+        if (graph.getNumVertices() != (*this)._numVertices)
+        {
+            throw invalid_argument("Invalid graph: The contraction hierarchy belongs to a different graph");
+        }
+        if (start >= (*this)._numVertices || end >= (*this)._numVertices)
+        {
+            throw invalid_argument("Invalid start or end vertex");
+        }
+
+        // One forward search space answers the distance from start to every vertex checked below
+        vector<pair<size_t, long long>> forwardSpace;
+        upwardSearch(start, forwardSpace);
+        long long length = boundedDistance(forwardSpace, end, LLONG_MAX - 1);
+        if (length == LLONG_MAX)
+        {
+            return vector<size_t>();
+        }
+
+        const AdjacencyIndex& inEdges = graph.getInEdges();
+        vector<size_t> path(1, end);
+        vector<pair<long long, size_t>> candidates;
+        size_t current = end;
+        long long currentDistance = length;
+        while (current != start)
+        {
+            // An in-neighbour u is on a shortest path iff d(start, u) = d(start, current) - w(u, current)
+            candidates.clear();
+            for (size_t e = inEdges.offsets[current]; e < inEdges.offsets[current + 1]; e++)
+            {
+                if (inEdges.weights[e] <= currentDistance)
+                {
+                    candidates.push_back(make_pair(currentDistance - inEdges.weights[e], inEdges.targets[e]));
+                }
+            }
+            sort(candidates.begin(), candidates.end());
+
+            size_t i = 0;
+            while (boundedDistance(forwardSpace, candidates[i].second, candidates[i].first) != candidates[i].first)
+            {
+                i++;
+            }
+            currentDistance = candidates[i].first;
+            current = candidates[i].second;
+            path.push_back(current);
+        }
+
+        reverse(path.begin(), path.end());
+        return path;
+    }
+}
@@ -0,0 +1,153 @@
+// Email: origoldbsc@gmail.com
+
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include "Graph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+namespace ariel {
+
+/**
+* @brief This class represents a contraction hierarchy (CH) of a graph with non-negative weights.
+*
+* The vertices are contracted one by one in order of importance; contracting a vertex adds a shortcut u->x for every path
+* u->v->x that has no other path (a witness) of the same length or shorter. Every shortest path then has a counterpart of
+* the same length that only goes up the hierarchy and then only down, so a query searches upwards from both of its ends.
+*/
+class ContractionHierarchy {
+
+    private:
+        size_t _numVertices;                    // The number of vertices of the indexed graph
+        size_t _numShortcuts;                   // The number of shortcuts added by the contraction
+        uint64_t _fingerprint;                  // A hash of the edges of the indexed graph
+        vector<size_t> _upOffsets;              // The arcs u->x to more important vertices x, in CSR form by u
+        vector<uint32_t> _upTargets;
+        vector<long long> _upWeights;
+        vector<size_t> _downOffsets;            // The arcs u->x from more important vertices u, in CSR form by x
+        vector<uint32_t> _downSources;
+        vector<long long> _downWeights;
+
+
+        /**
+         * @brief This auxiliary function runs a full upward search from a vertex.
+         *
+         * Vertices that are reached more cheaply through a more important vertex are stalled (not expanded), since their
+         * distance is not exact and no shortest path goes up through them.
+         *
+         * @param source The vertex to start from.
+         * @param distance Filled with the settled vertices and their distances, sorted by vertex (cleared first).
+         */
+        void upwardSearch(size_t source, vector<pair<size_t, long long>>& distance) const;
+
+
+        /**
+         * @brief This auxiliary function checks if the distance between two vertices is at most a bound.
+         *
+         * @param forwardSpace The sorted result of the forward upward search from the first vertex.
+         * @param target The second vertex.
+         * @param bound The bound.
+         * @return The distance if it is at most the bound, otherwise LLONG_MAX.
+         */
+        long long boundedDistance(const vector<pair<size_t, long long>>& forwardSpace, size_t target, long long bound) const;
+
+
+    public:
+
+        /**
+         * @brief A default constructor for the ContractionHierarchy class (an index of no vertices).
+         */
+        ContractionHierarchy();
+
+
+        /**
+         * @brief This method contracts a graph and builds its hierarchy.
+         *
+         * The next vertex to contract is the one with the smallest edge difference (shortcuts added minus arcs removed) plus
+         * number of contracted neighbours, with lazy updates. Witness searches are bounded, so a few redundant shortcuts
+         * may be added. Building takes minutes on graphs with millions of vertices.
+         *
+         * @param graph The graph.
+         * @return The hierarchy.
+         * @throws If the graph has negative weights throw invalid_argument exception
+         */
+        static ContractionHierarchy build(const Graph& graph);
+
+
+        /**
+         * @brief This method saves the hierarchy to a binary file.
+         *
+         * @param path The path of the file.
+         * @throws If the file cannot be written throw runtime_error exception
+         */
+        void save(const string& path) const;
+
+
+        /**
+         * @brief This method loads a hierarchy saved by save().
+         *
+         * @param path The path of the file.
+         * @return The hierarchy stored in the file.
+         * @throws If the file cannot be read throw runtime_error exception, if it is not a valid hierarchy file throw
+         * invalid_argument exception
+         */
+        static ContractionHierarchy load(const string& path);
+
+
+        /**
+         * @brief This method checks if the hierarchy was built for a graph (same vertices, edges and weights).
+         * @param graph The graph.
+         * @return true if the hierarchy belongs to the graph; otherwise, false.
+         */
+        bool matches(const Graph& graph) const;
+
+
+        /**
+         * @brief This method returns the number of vertices of the indexed graph.
+         * @return The number of vertices.
+         */
+        size_t getNumVertices() const;
+
+
+        /**
+         * @brief This method returns the number of shortcuts added by the contraction.
+         * @return The number of shortcuts.
+         */
+        size_t getNumShortcuts() const;
+
+
+        /**
+         * @brief This method finds the distance between two vertices with a bidirectional upward search.
+         *
+         * @param start The start vertex.
+         * @param end The end vertex.
+         * @return The distance, or LLONG_MAX if end is unreachable from start.
+         * @throws If a vertex is invalid throw invalid_argument exception
+         */
+        long long distance(size_t start, size_t end) const;
+
+
+        /**
+         * @brief This method finds the shortest path between two vertices.
+         *
+         * The path is the one a forward Dijkstra's search returns: walking back from end, the parent of each vertex is its
+         * in-neighbour on a shortest path with the smallest (distance from start, index). Candidates are checked in that
+         * order with upward searches that are cut off at the required distance.
+         *
+         * @param graph The indexed graph (its in-edges are used to walk back from end).
+         * @param start The start vertex.
+         * @param end The end vertex.
+         * @return The vertices of the path from start to end, or an empty vector if end is unreachable from start.
+         * @throws If a vertex is invalid or the graph has a different number of vertices throw invalid_argument exception
+         */
+        vector<size_t> path(const Graph& graph, size_t start, size_t end) const;
+};
+
+}
+
+#endif
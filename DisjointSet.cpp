@@ -0,0 +1,138 @@
+// Email: origoldbsc@gmail.com
+
+#include "DisjointSet.hpp"
+#include <utility>
+
+namespace ariel {
+
+    /**
+     * @brief A constructor that creates a set of singletons.
+     * @param size The number of elements.
+     */
+    DisjointSet::DisjointSet(size_t size) : _parent(new atomic<size_t>[size]), _rank(size, 0), _size(size)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            (*this)._parent[i].store(i, memory_order_relaxed);
+        }
+    }
+
+
+    /**
+     * @brief This method returns the number of elements.
+     * @return The number of elements.
+     */
+    size_t DisjointSet::size() const
+    {
+        return (*this)._size;
+    }
+
+
+    /**
+     * @brief This method finds the representative of the set of an element, compressing the path to it.
+     * @param element The element.
+     * @return The root of the element's set.
+     */
+    size_t DisjointSet::find(size_t element)
+    {
+        // Find the root
+        size_t root = element;
+        while ((*this)._parent[root].load(memory_order_relaxed) != root)
+        {
+            root = (*this)._parent[root].load(memory_order_relaxed);
+        }
+
+        // Point every element on the path directly to the root
+        while (element != root)
+        {
+            size_t next = (*this)._parent[element].load(memory_order_relaxed);
+            (*this)._parent[element].store(root, memory_order_relaxed);
+            element = next;
+        }
+
+        return root;
+    }
+
+
+    /**
+     * @brief This method merges the sets of two elements using union by rank.
+     * @param element_a The first element.
+     * @param element_b The second element.
+     * @return true if the sets were different and got merged; otherwise, false.
+     */
+    bool DisjointSet::unite(size_t element_a, size_t element_b)
+    {
+        size_t root_a = find(element_a);
+        size_t root_b = find(element_b);
+        if (root_a == root_b)
+        {
+            return false;
+        }
+
+        // Attach the shallower tree under the deeper one
+        if ((*this)._rank[root_a] < (*this)._rank[root_b])
+        {
+            swap(root_a, root_b);
+        }
+        (*this)._parent[root_b].store(root_a, memory_order_relaxed);
+        if ((*this)._rank[root_a] == (*this)._rank[root_b])
+        {
+            (*this)._rank[root_a]++;
+        }
+
+        return true;
+    }
+
+
+    /**
+     * @brief This method finds the representative of the set of an element; it is safe to call concurrently.
+     * @param element The element.
+     * @return The root of the element's set at some point during the call.
+     */
+    size_t DisjointSet::findConcurrent(size_t element)
+    {
+        size_t parent = (*this)._parent[element].load(memory_order_acquire);
+        while (parent != element)
+        {
+            // Path halving: try to skip a level; a failed exchange only means another thread changed the link
+            size_t grandparent = (*this)._parent[parent].load(memory_order_acquire);
+            size_t expected = parent;
+            (*this)._parent[element].compare_exchange_weak(expected, grandparent, memory_order_acq_rel, memory_order_acquire);
+            element = parent;
+            parent = grandparent;
+        }
+        return element;
+    }
+
+
+    /**
+     * @brief This method merges the sets of two elements without locks; it is safe to call concurrently.
+     * @param element_a The first element.
+     * @param element_b The second element.
+     * @return true if this call merged two different sets; otherwise, false.
+     */
+    bool DisjointSet::uniteConcurrent(size_t element_a, size_t element_b)
+    {
+        while (true)
+        {
+            size_t root_a = findConcurrent(element_a);
+            size_t root_b = findConcurrent(element_b);
+            if (root_a == root_b)
+            {
+                return false;
+            }
+
+            // Always link the larger root under the smaller one, so concurrent links can never form a cycle
+            if (root_a < root_b)
+            {
+                swap(root_a, root_b);
+            }
+            size_t expected = root_a;
+            if ((*this)._parent[root_a].compare_exchange_strong(expected, root_b, memory_order_acq_rel))
+            {
+                return true;
+            }
+            // Another thread linked root_a first; retry from the new roots
+        }
+    }
+}
@@ -0,0 +1,85 @@
+// Email: origoldbsc@gmail.com
+
+#ifndef DISJOINTSET_HPP
+#define DISJOINTSET_HPP
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+namespace ariel {
+
+/**
+* @brief This class represents a disjoint-set (union-find) structure over the elements 0 .. size - 1.
+*
+* Sequential unions use union by rank and finds compress paths, so a sequence of operations runs in near-linear time.
+* The concurrent operations are lock-free and may be called from several threads at once: they link the root with the
+* larger index under the root with the smaller one by compare-and-swap, and halve paths while searching.
+* The two modes must not be mixed while a concurrent phase is running.
+*/
+class DisjointSet {
+
+    private:
+        unique_ptr<atomic<size_t>[]> _parent;       // The parent of each element (a root is its own parent)
+        vector<unsigned char> _rank;                // An upper bound on the height of each root's tree (sequential mode)
+        size_t _size;                               // The number of elements
+
+    public:
+
+        /**
+         * @brief A constructor that creates a set of singletons.
+         * @param size The number of elements.
+         */
+        explicit DisjointSet(size_t size);
+
+        DisjointSet(const DisjointSet&) = delete;
+        DisjointSet& operator=(const DisjointSet&) = delete;
+
+
+        /**
+         * @brief This method returns the number of elements.
+         * @return The number of elements.
+         */
+        size_t size() const;
+
+
+        /**
+         * @brief This method finds the representative of the set of an element, compressing the path to it.
+         * @param element The element.
+         * @return The root of the element's set.
+         */
+        size_t find(size_t element);
+
+
+        /**
+         * @brief This method merges the sets of two elements using union by rank.
+         * @param element_a The first element.
+         * @param element_b The second element.
+         * @return true if the sets were different and got merged; otherwise, false.
+         */
+        bool unite(size_t element_a, size_t element_b);
+
+
+        /**
+         * @brief This method finds the representative of the set of an element; it is safe to call concurrently.
+         * @param element The element.
+         * @return The root of the element's set at some point during the call.
+         */
+        size_t findConcurrent(size_t element);
+
+
+        /**
+         * @brief This method merges the sets of two elements without locks; it is safe to call concurrently.
+         * @param element_a The first element.
+         * @param element_b The second element.
+         * @return true if this call merged two different sets; otherwise, false.
+         */
+        bool uniteConcurrent(size_t element_a, size_t element_b);
+};
+
+}
+
+#endif
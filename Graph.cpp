@@ -1,15 +1,111 @@
 // Email: origoldbsc@gmail.com
 
 #include "Graph.hpp"
+#include "LandmarkIndex.hpp"
+#include "ContractionHierarchy.hpp"
 #include <stdexcept>
+#include <climits>
 #include <cmath>
+#include <algorithm>
 
 namespace ariel {
 
+    /*********************************************/
+    ///             ADJACENCY INDEX             ///
+    /*********************************************/
+
+    /**
+     * @brief This method points the arrays of the index to its own storage vectors.
+     */
+    void AdjacencyIndex::adoptStorage()
+    {
+        (*this).offsets = (*this).offsetStorage.data();
+        (*this).targets = (*this).targetStorage.data();
+        (*this).weights = (*this).weightStorage.data();
+    }
+
+
+    /**
+     * @brief This method returns the number of edges stored in the index.
+     * 
+     * @return The number of (directed) entries.
+     */
+    size_t AdjacencyIndex::numEntries() const
+    {
+        return (*this).offsets[(*this).numVertices];
+    }
+
+
+    /**
+     * @brief This method returns the number of edges leaving a vertex.
+     * 
+     * @param vertex The vertex.
+     * @return The out-degree of the vertex.
+     */
+    size_t AdjacencyIndex::degree(size_t vertex) const
+    {
+        return (*this).offsets[vertex + 1] - (*this).offsets[vertex];
+    }
+
+
+    /**
+     * @brief This method finds the weight of the edge source->target by binary search.
+     * 
+     * @param source The source vertex.
+     * @param target The target vertex.
+     * @return The weight of the edge, or 0 if there is no such edge.
+     */
+    int AdjacencyIndex::findWeight(size_t source, size_t target) const
+    {
+        const uint32_t* first = (*this).targets + (*this).offsets[source];
+        const uint32_t* last = (*this).targets + (*this).offsets[source + 1];
+        const uint32_t* found = lower_bound(first, last, target);
+        if (found == last || *found != target)
+        {
+            return 0;
+        }
+        return (*this).weights[found - (*this).targets];
+    }
+
+
+    /*********************************************/
+    ///                  GRAPH                  ///
+    /*********************************************/
+
     /**
      * @brief A default constructor for the Graph class.
      */
-    Graph::Graph() : _numVertices(0), _numEdges(0), _isDirected(false) {}
+    Graph::Graph() : _numVertices(0), _numEdges(0), _isDirected(false), _storage(Storage::OwnedDense), _denseData(nullptr), _denseStride(0) {}
+
+
+    /**
+     * @brief A constructor that wraps a caller-owned adjacency matrix without copying it.
+     * 
+     * The conversion is explicit: wrapping a view scans the matrix once (to count the edges and check the direction),
+     * and the first algorithm run on the graph builds its CSR index. Wrap a view once and reuse the graph for every query.
+     * @note The buffer must outlive the graph and must not change while the graph is in use. Modifying the graph
+     * (e.g. with operator*=) first copies the matrix, so the buffer itself is never written.
+     * @param view The view of the matrix.
+     * @throws If the view is empty or its stride is shorter than a row throw invalid_argument exception
+     */
+    Graph::Graph(const GraphView& view) : Graph()
+    {
+        if (view.numVertices == 0 || view.data == nullptr) 
+        {
+            throw invalid_argument("Invalid graph: The graph matrix is empty");
+        }
+        if (view.stride < view.numVertices) 
+        {
+            throw invalid_argument("Invalid graph: The stride is shorter than a row of the matrix");
+        }
+
+        (*this)._numVertices = view.numVertices;
+        (*this)._storage = Storage::ExternalDense;
+        (*this)._denseData = view.data;
+        (*this)._denseStride = view.stride;
+        (*this)._isDirected = checkDirected();
+        (*this)._numEdges = countEdges();
+    }
 
 
     /**
@@ -38,13 +134,102 @@ namespace ariel {
             }
         }
 
-        (*this)._adjacencyMatrix = matrix;
+        vector<vector<int>> copy = matrix;
+        adoptMatrix(copy);
+    }
 
-        // Check if the graph is directed or not
-        (*this)._isDirected = checkDirected();
 
-        // Count the number of edges based on graph type
-        (*this)._numEdges = countEdges();
+    /**
+     * @brief This method builds a graph in sparse storage directly from a list of edges, without an adjacency matrix.
+     * 
+     * Edges with weight 0 are ignored, and if an edge appears more than once the last occurrence wins.
+     * @param numVertices The number of vertices.
+     * @param edges The edges of the graph.
+     * @return The resulting graph.
+     * @throws If there are no vertices or an edge has an invalid vertex throw invalid_argument exception
+     */
+    Graph Graph::fromEdges(size_t numVertices, const vector<Edge>& edges)
+    {
+        if (numVertices == 0)
+        {
+            throw invalid_argument("Invalid graph: The graph matrix is empty");
+        }
+        if (numVertices > UINT32_MAX)
+        {
+            throw invalid_argument("Invalid graph: Too many vertices for sparse storage");
+        }
+
+        // Count the edges by source and by target
+        vector<size_t> bySource(numVertices + 1, 0);
+        vector<size_t> byTarget(numVertices + 1, 0);
+        size_t numEntries = 0;
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            if (edges[i].weight == 0)
+            {
+                continue;
+            }
+            if (edges[i].source >= numVertices || edges[i].target >= numVertices)
+            {
+                throw invalid_argument("Invalid graph: Edge " + to_string(edges[i].source) + "->" + to_string(edges[i].target) + " is out of range");
+            }
+            bySource[edges[i].source + 1]++;
+            byTarget[edges[i].target + 1]++;
+            numEntries++;
+        }
+        for (size_t v = 0; v < numVertices; v++)
+        {
+            bySource[v + 1] += bySource[v];
+            byTarget[v + 1] += byTarget[v];
+        }
+
+        // Two stable counting sorts (by target, then by source) order the edges by (source, target) in linear time,
+        // keeping duplicates in input order
+        vector<size_t> sortedByTarget(numEntries);
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            if (edges[i].weight != 0)
+            {
+                sortedByTarget[byTarget[edges[i].target]++] = i;
+            }
+        }
+        vector<size_t> sorted(numEntries);
+        vector<size_t> cursor(bySource.begin(), bySource.end() - 1);
+        for (size_t k = 0; k < numEntries; k++)
+        {
+            const Edge& edge = edges[sortedByTarget[k]];
+            sorted[cursor[edge.source]++] = sortedByTarget[k];
+        }
+
+        // Fill the index, keeping only the last occurrence of every duplicate edge
+        shared_ptr<AdjacencyIndex> index = make_shared<AdjacencyIndex>();
+        index->numVertices = numVertices;
+        index->offsetStorage.assign(numVertices + 1, 0);
+        index->targetStorage.reserve(numEntries);
+        index->weightStorage.reserve(numEntries);
+        for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u++)
+        {
+            for (size_t k = bySource[vertex_u]; k < bySource[vertex_u + 1]; k++)
+            {
+                const Edge& edge = edges[sorted[k]];
+                if (k + 1 < bySource[vertex_u + 1] && edges[sorted[k + 1]].target == edge.target)
+                {
+                    continue;
+                }
+                index->targetStorage.push_back(static_cast<uint32_t>(edge.target));
+                index->weightStorage.push_back(edge.weight);
+            }
+            index->offsetStorage[vertex_u + 1] = index->targetStorage.size();
+        }
+        index->adoptStorage();
+
+        Graph graph;
+        graph._numVertices = numVertices;
+        graph._storage = Storage::Sparse;
+        graph._outEdges.reset(index);
+        graph._isDirected = graph.checkDirected();
+        graph._numEdges = graph.countEdges();
+        return graph;
     }
 
 
@@ -54,17 +239,17 @@ namespace ariel {
     string Graph::printGraph() const 
     {
         string result;
-        for (size_t i = 0; i < (*this)._adjacencyMatrix.size(); i++) 
+        for (size_t i = 0; i < (*this)._numVertices; i++) 
         {
             if (i != 0) 
             {
                 result += "\n";
             }
             result += "[";
-            for (size_t j = 0; j < (*this)._adjacencyMatrix[i].size(); j++) 
+            for (size_t j = 0; j < (*this)._numVertices; j++) 
             {
-                result += to_string((*this)._adjacencyMatrix[i][j]);
-                if (j < (*this)._adjacencyMatrix[i].size() - 1) 
+                result += to_string(getEdgeWeight(i, j));
+                if (j < (*this)._numVertices - 1) 
                 {
                     result += ", ";
                 }
@@ -95,6 +280,30 @@ namespace ariel {
         return (*this)._numEdges;
     }
 
+
+    /**
+     * @brief This method returns the smallest weight of an edge in the graph.
+     *
+     * The weight range is computed on the first call and cached until the graph is modified.
+     * @return The smallest weight, or 0 if the graph has no edges.
+     */
+    int Graph::getMinWeight() const 
+    {
+        return getWeightRange().first;
+    }
+
+
+    /**
+     * @brief This method returns the largest weight of an edge in the graph.
+     *
+     * The weight range is computed on the first call and cached until the graph is modified.
+     * @return The largest weight, or 0 if the graph has no edges.
+     */
+    int Graph::getMaxWeight() const 
+    {
+        return getWeightRange().second;
+    }
+
     /**
      * @brief This method returns if the graph is directed or not.
      * 
@@ -105,14 +314,208 @@ namespace ariel {
         return (*this)._isDirected;
     }
 
+    /**
+     * @brief This method returns the weight of the edge u->v.
+     * 
+     * @param vertex_u The source vertex.
+     * @param vertex_v The target vertex.
+     * @return The weight of the edge, or 0 if there is no such edge.
+     */
+    int Graph::getEdgeWeight(size_t vertex_u, size_t vertex_v) const
+    {
+        const int* row = denseRow(vertex_u);
+        if (row != nullptr)
+        {
+            return row[vertex_v];
+        }
+        return getOutEdges().findWeight(vertex_u, vertex_v);
+    }
+
+    /**
+     * @brief This method returns the CSR index of the edges leaving each vertex.
+     * 
+     * For densely stored graphs the index is built on the first call and cached until the graph is modified.
+     * @note Several threads may call this method at once; the index is built only once.
+     * @return A reference to the index.
+     */
+    const AdjacencyIndex& Graph::getOutEdges() const
+    {
+        return (*this)._outEdges.get([this]()
+        {
+            shared_ptr<AdjacencyIndex> index = make_shared<AdjacencyIndex>();
+            index->numVertices = (*this)._numVertices;
+            index->offsetStorage.reserve((*this)._numVertices + 1);
+            index->offsetStorage.push_back(0);
+
+            // Collect the non-zero entries of each row, which are already sorted by target
+            for (size_t vertex_u = 0; vertex_u < (*this)._numVertices; vertex_u++)
+            {
+                const int* row = denseRow(vertex_u);
+                for (size_t vertex_v = 0; vertex_v < (*this)._numVertices; vertex_v++)
+                {
+                    if (row[vertex_v] != 0)
+                    {
+                        index->targetStorage.push_back(static_cast<uint32_t>(vertex_v));
+                        index->weightStorage.push_back(row[vertex_v]);
+                    }
+                }
+                index->offsetStorage.push_back(index->targetStorage.size());
+            }
+
+            index->adoptStorage();
+            return shared_ptr<const AdjacencyIndex>(index);
+        });
+    }
+
+
+    /**
+     * @brief This method returns the CSR index of the edges entering each vertex (row v lists the sources of the edges u->v).
+     *
+     * For undirected graphs this is the out-edge index itself; otherwise it is built on the first call and cached until
+     * the graph is modified.
+     * @note Several threads may call this method at once; the index is built only once.
+     * @return A reference to the index.
+     */
+    const AdjacencyIndex& Graph::getInEdges() const
+    {
+        const AdjacencyIndex& outEdges = getOutEdges();
+        if (!(*this)._isDirected)
+        {
+            return outEdges;
+        }
+
+        return (*this)._inEdges.get([this, &outEdges]()
+        {
+            shared_ptr<AdjacencyIndex> index = make_shared<AdjacencyIndex>();
+            size_t numEntries = outEdges.numEntries();
+            index->numVertices = (*this)._numVertices;
+            index->offsetStorage.assign((*this)._numVertices + 1, 0);
+            index->targetStorage.resize(numEntries);
+            index->weightStorage.resize(numEntries);
+
+            // Count the edges entering each vertex
+            for (size_t e = 0; e < numEntries; e++)
+            {
+                index->offsetStorage[outEdges.targets[e] + 1]++;
+            }
+            for (size_t v = 0; v < (*this)._numVertices; v++)
+            {
+                index->offsetStorage[v + 1] += index->offsetStorage[v];
+            }
+
+            // Scatter the edges by target; visiting the sources in order keeps each row sorted
+            vector<size_t> position(index->offsetStorage.begin(), index->offsetStorage.end() - 1);
+            for (size_t vertex_u = 0; vertex_u < (*this)._numVertices; vertex_u++)
+            {
+                for (size_t e = outEdges.offsets[vertex_u]; e < outEdges.offsets[vertex_u + 1]; e++)
+                {
+                    size_t slot = position[outEdges.targets[e]]++;
+                    index->targetStorage[slot] = static_cast<uint32_t>(vertex_u);
+                    index->weightStorage[slot] = outEdges.weights[e];
+                }
+            }
+
+            index->adoptStorage();
+            return shared_ptr<const AdjacencyIndex>(index);
+        });
+    }
+
+    /**
+     * @brief This method returns a pointer to a row of the adjacency matrix of a densely stored graph.
+     *
+     * @param vertex The row to return.
+     * @return A pointer to the numVertices weights of the row, or nullptr if the graph is stored sparsely.
+     */
+    const int* Graph::getDenseRow(size_t vertex) const
+    {
+        return denseRow(vertex);
+    }
+
+
+    /**
+     * @brief This method returns the ALT landmark index of the graph, used to speed up repeated shortest path queries.
+     *
+     * The index is built on the first call (two Dijkstra searches per landmark) and cached until the graph is modified.
+     * It is never built implicitly; once it exists, shortestPath() uses it.
+     * @note Several threads may call this method at once; the index is built only once.
+     * @return A reference to the index.
+     * @throws If the graph has negative weights throw invalid_argument exception
+     */
+    const LandmarkIndex& Graph::getLandmarks() const
+    {
+        return (*this)._landmarks.get([this]()
+        {
+            return shared_ptr<const LandmarkIndex>(make_shared<LandmarkIndex>(LandmarkIndex::build(*this, LandmarkIndex::DEFAULT_NUM_LANDMARKS)));
+        });
+    }
+
+
+    /**
+     * @brief This method checks if the landmark index of the graph is already built.
+     * @return true if the index is cached; otherwise, false.
+     */
+    bool Graph::hasLandmarks() const
+    {
+        return (*this)._landmarks.isBuilt();
+    }
+
+
+    /**
+     * @brief This method returns the contraction hierarchy of the graph, used to answer shortest path queries quickly.
+     *
+     * The hierarchy is built on the first call and cached until the graph is modified. Building it takes minutes on
+     * graphs with millions of vertices, so it is never built implicitly; once it exists, shortestPath() uses it.
+     * @note Several threads may call this method at once; the hierarchy is built only once.
+     * @return A reference to the hierarchy.
+     * @throws If the graph has negative weights throw invalid_argument exception
+     */
+    const ContractionHierarchy& Graph::getContractionHierarchy() const
+    {
+        return (*this)._hierarchy.get([this]()
+        {
+            return shared_ptr<const ContractionHierarchy>(make_shared<ContractionHierarchy>(ContractionHierarchy::build(*this)));
+        });
+    }
+
+
+    /**
+     * @brief This method attaches a hierarchy that was built earlier (e.g. loaded from a file) to the graph.
+     *
+     * @param hierarchy The hierarchy.
+     * @throws If the hierarchy was built for a different graph throw invalid_argument exception
+     */
+    void Graph::setContractionHierarchy(ContractionHierarchy hierarchy)
+    {
+        if (!hierarchy.matches(*this))
+        {
+            throw invalid_argument("Invalid graph: The contraction hierarchy belongs to a different graph");
+        }
+        (*this)._hierarchy.reset(make_shared<ContractionHierarchy>(move(hierarchy)));
+    }
+
+
+    /**
+     * @brief This method checks if the graph has a contraction hierarchy.
+     * @return true if the hierarchy is cached; otherwise, false.
+     */
+    bool Graph::hasContractionHierarchy() const
+    {
+        return (*this)._hierarchy.isBuilt();
+    }
+
+
     /**
      * @brief This method returns the adjacency matrix of the graph. 
      * 
      * A 2D array represented by vetcor of vectors.
+     * @note A graph backed by external memory or sparse storage is first converted to an owned matrix.
      * @return A reference to the adjacency matrix.
      */
     vector<vector<int>>& Graph::getAdjacencyMatrix() 
     {
+        // The caller may modify the matrix through the returned reference, so cached indexes cannot be trusted anymore
+        materialize();
+        invalidateIndexes();
         return (*this)._adjacencyMatrix;
     }
 
@@ -148,8 +551,7 @@ namespace ariel {
         }
 
         // Check if the graphs are square matrices
-        if ((*this)._adjacencyMatrix.size() != (*this)._adjacencyMatrix[0].size() || 
-        other._adjacencyMatrix.size() != other._adjacencyMatrix[0].size()) 
+        if (!(*this).isSquare() || !other.isSquare()) 
         {
             throw invalid_argument("Invalid operation: one or both graphs are non-square graphs");
         }
@@ -161,7 +563,7 @@ namespace ariel {
         {
             for (size_t j = 0; j < (*this)._numVertices; j++) 
             {
-                nexMatrix[i][j] = (*this)._adjacencyMatrix[i][j] + other._adjacencyMatrix[i][j];
+                nexMatrix[i][j] = getEdgeWeight(i, j) + other.getEdgeWeight(i, j);
             }
         }
 
@@ -179,6 +581,8 @@ namespace ariel {
      */
     Graph& Graph::operator+=(int scalar) 
     {
+        materialize();
+
         for (size_t i = 0; i < (*this)._numVertices; i++) 
         {
             for (size_t j = 0; j < (*this)._numVertices; j++) 
@@ -189,7 +593,8 @@ namespace ariel {
                 }
             }
         }
-        // Update the number of edges
+        // Drop the stale indexes and update the number of edges
+        invalidateIndexes();
         (*this)._numEdges = countEdges();
         return *this;
     }
@@ -202,6 +607,7 @@ namespace ariel {
      */
     Graph& Graph::operator-()  
     {
+        materialize();
         for (size_t i = 0; i < (*this)._numVertices; i++)
         {
             for (size_t j = 0; j < (*this)._numVertices; j++)
@@ -209,6 +615,8 @@ namespace ariel {
                 (*this)._adjacencyMatrix[i][j] = -1 * (*this)._adjacencyMatrix[i][j];
             }
         }
+
+        invalidateIndexes();
         
         return *this;
     }
@@ -230,8 +638,7 @@ namespace ariel {
         }
 
         // Check if the graphs are square matrices
-        if ((*this)._adjacencyMatrix.size() != (*this)._adjacencyMatrix[0].size() || 
-        other._adjacencyMatrix.size() != other._adjacencyMatrix[0].size()) 
+        if (!(*this).isSquare() || !other.isSquare()) 
         {
             throw invalid_argument("Invalid operation: one or both graphs are non-square graphs");
         }
@@ -242,7 +649,7 @@ namespace ariel {
         for (size_t i = 0; i < (*this)._numVertices; i++) 
         {
             for (size_t j = 0; j < _numVertices; j++) {
-                nexMatrix[i][j] = (*this)._adjacencyMatrix[i][j] - other._adjacencyMatrix[i][j];
+                nexMatrix[i][j] = getEdgeWeight(i, j) - other.getEdgeWeight(i, j);
             }
         }
 
@@ -260,6 +667,8 @@ namespace ariel {
      */
     Graph& Graph::operator-=(int scalar) 
     {
+        materialize();
+
         for (size_t i = 0; i < (*this)._numVertices; i++) 
         {
             for (size_t j = 0; j < (*this)._numVertices; j++) 
@@ -271,7 +680,8 @@ namespace ariel {
             }
         }
 
-        // Update the number of edges
+        // Drop the stale indexes and update the number of edges
+        invalidateIndexes();
         (*this)._numEdges = countEdges();
         return *this;
     }
@@ -301,7 +711,7 @@ namespace ariel {
             {
                 for (size_t k = 0; k < (*this)._numVertices; k++) 
                 {
-                    newMatrix[i][j] += (*this)._adjacencyMatrix[i][k] * other._adjacencyMatrix[k][j];
+                    newMatrix[i][j] += getEdgeWeight(i, k) * other.getEdgeWeight(k, j);
                 }
             }
         }
@@ -320,6 +730,7 @@ namespace ariel {
      */
     Graph& Graph::operator*=(int scalar) 
     {
+        materialize();
 
         // Multiply each edge in the adj. matrix by the scalar
         for (size_t i = 0; i < (*this)._numVertices; i++) 
@@ -330,7 +741,8 @@ namespace ariel {
             }
         }
 
-        // Update the number of edges
+        // Drop the stale indexes and update the number of edges
+        invalidateIndexes();
         (*this)._numEdges = countEdges(); 
         return *this;
     }
@@ -350,6 +762,7 @@ namespace ariel {
         {
             throw invalid_argument("Invalid operation: Division by zero");
         }
+        materialize();
 
         // Divide each non-zero edge in the adj. matrix by the scalar
         for (size_t i = 0; i < (*this)._numVertices; i++) 
@@ -364,7 +777,8 @@ namespace ariel {
             }
         }
 
-        // Update the number of edges
+        // Drop the stale indexes and update the number of edges
+        invalidateIndexes();
         (*this)._numEdges = countEdges();
         return *this;
     }
@@ -395,7 +809,7 @@ namespace ariel {
         {
             for (size_t j = 0; j < (*this)._numVertices; j++) 
             {
-                if ((*this)._adjacencyMatrix[i][j] != other._adjacencyMatrix[i][j]) {
+                if (getEdgeWeight(i, j) != other.getEdgeWeight(i, j)) {
                     equalEdges = false;
                     break;
                 }
@@ -509,6 +923,8 @@ namespace ariel {
      */
     Graph& Graph::operator++() 
     {   
+        materialize();
+
         // Increment the weight of each non-zero edge
         for (size_t i = 0; i < (*this)._numVertices; i++) 
         {
@@ -521,7 +937,8 @@ namespace ariel {
             }
         }
 
-        // Update number of edges
+        // Drop the stale indexes and update number of edges
+        invalidateIndexes();
         (*this)._numEdges = countEdges();
         return *this;   
     }
@@ -547,6 +964,8 @@ namespace ariel {
      */
     Graph& Graph::operator--() 
     {
+        materialize();
+
         // Decrement the weight of each non-zero edge
         for (size_t i = 0; i < (*this)._numVertices; i++) 
         {
@@ -559,7 +978,8 @@ namespace ariel {
             }
         }
 
-        // Update number of edges
+        // Drop the stale indexes and update number of edges
+        invalidateIndexes();
         (*this)._numEdges = countEdges();
         return *this;
     }
@@ -605,11 +1025,29 @@ namespace ariel {
     */
     bool Graph::checkDirected() 
     {
+        // For sparse storage compare every stored edge with its reverse edge
+        if ((*this)._storage == Storage::Sparse)
+        {
+            const AdjacencyIndex& edges = getOutEdges();
+            for (size_t vertex_v = 0; vertex_v < _numVertices; vertex_v++) 
+            {
+                for (size_t e = edges.offsets[vertex_v]; e < edges.offsets[vertex_v + 1]; e++)
+                {
+                    if (edges.findWeight(edges.targets[e], vertex_v) != edges.weights[e])
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
         for (size_t vertex_v = 0; vertex_v < _numVertices; vertex_v++) 
         {
+            const int* row_v = denseRow(vertex_v);
             for (size_t vertex_u = 0; vertex_u < _numVertices; vertex_u++) 
             {
-                if ((*this)._adjacencyMatrix[vertex_v][vertex_u] != (*this)._adjacencyMatrix[vertex_u][vertex_v]) 
+                if (row_v[vertex_u] != denseRow(vertex_u)[vertex_v]) 
                 {
                     return true;
                 }
@@ -627,14 +1065,37 @@ namespace ariel {
     size_t Graph::countEdges() 
     {
         size_t count = 0;
+
+        // For sparse storage every entry is an edge (undirected edges are stored in both directions)
+        if ((*this)._storage == Storage::Sparse)
+        {
+            const AdjacencyIndex& edges = getOutEdges();
+            if ((*this)._isDirected)
+            {
+                return edges.numEntries();
+            }
+            for (size_t i = 0; i < (*this)._numVertices; i++) 
+            {
+                for (size_t e = edges.offsets[i]; e < edges.offsets[i + 1]; e++)
+                {
+                    if (edges.targets[e] >= i)
+                    {
+                        count++;
+                    }
+                }
+            }
+            return count;
+        }
+
         if ((*this)._isDirected) 
         {
             // Count edges for directed graph
             for (size_t i = 0; i < (*this)._numVertices; i++) 
             {
+                const int* row = denseRow(i);
                 for (size_t j = 0; j < (*this)._numVertices; j++) 
                 {
-                    if ((*this)._adjacencyMatrix[i][j] != 0) 
+                    if (row[j] != 0) 
                     {
                         count++;
                     }
@@ -646,9 +1107,10 @@ namespace ariel {
             // Count edges for undirected graph
             for (size_t i = 0; i < (*this)._numVertices; i++) 
             {
+                const int* row = denseRow(i);
                 for (size_t j = i; j < (*this)._numVertices; j++) 
                 {
-                    if ((*this)._adjacencyMatrix[i][j] != 0) 
+                    if (row[j] != 0) 
                     {
                         count++;
                     }
@@ -676,7 +1138,7 @@ namespace ariel {
         {
             for (size_t j = 0; j < (*this)._numVertices; j++)
             {
-                if ((*this)._adjacencyMatrix[i][j] != 0 && other._adjacencyMatrix[i][j] == 0)
+                if (getEdgeWeight(i, j) != 0 && other.getEdgeWeight(i, j) == 0)
                 {
                     return false;
                 }
@@ -694,6 +1156,147 @@ namespace ariel {
      */
     bool Graph::compareMagnitude(const Graph& other) const
     {
-        return (*this)._adjacencyMatrix.size() < other._adjacencyMatrix.size();
+        return (*this)._numVertices < other._numVertices;
+    }
+
+
+    /**
+     * @brief This auxiliary function returns a pointer to a row of a densely stored graph.
+     * 
+     * @param vertex The row to return.
+     * @return A pointer to the numVertices weights of the row, or nullptr if the graph is stored sparsely.
+     */
+    const int* Graph::denseRow(size_t vertex) const
+    {
+        switch ((*this)._storage)
+        {
+            case Storage::OwnedDense:
+                return (*this)._adjacencyMatrix[vertex].data();
+            case Storage::ExternalDense:
+                return (*this)._denseData + vertex * (*this)._denseStride;
+            default:
+                return nullptr;
+        }
+    }
+
+
+    /**
+     * @brief This auxiliary function checks if the adjacency matrix of the graph is square.
+     * 
+     * @return True if the matrix is square, otherwise false.
+     */
+    bool Graph::isSquare() const
+    {
+        // External and sparse storage are square by construction
+        if ((*this)._storage != Storage::OwnedDense)
+        {
+            return true;
+        }
+        return (*this)._adjacencyMatrix.size() == (*this)._adjacencyMatrix[0].size();
+    }
+
+
+    /**
+     * @brief This auxiliary function converts the graph to an owned adjacency matrix so it can be modified in place.
+     * 
+     * Cached indexes are dropped, since they are about to become stale.
+     */
+    void Graph::materialize()
+    {
+        if ((*this)._storage == Storage::OwnedDense)
+        {
+            return;
+        }
+
+        vector<vector<int>> matrix((*this)._numVertices, vector<int>((*this)._numVertices, 0));
+        if ((*this)._storage == Storage::ExternalDense)
+        {
+            for (size_t i = 0; i < (*this)._numVertices; i++)
+            {
+                const int* row = denseRow(i);
+                matrix[i].assign(row, row + (*this)._numVertices);
+            }
+        }
+        else
+        {
+            const AdjacencyIndex& edges = getOutEdges();
+            for (size_t i = 0; i < (*this)._numVertices; i++)
+            {
+                for (size_t e = edges.offsets[i]; e < edges.offsets[i + 1]; e++)
+                {
+                    matrix[i][edges.targets[e]] = edges.weights[e];
+                }
+            }
+        }
+
+        (*this)._adjacencyMatrix.swap(matrix);
+        (*this)._storage = Storage::OwnedDense;
+        (*this)._denseData = nullptr;
+        (*this)._denseStride = 0;
+        (*this)._backing.reset();
+        invalidateIndexes();
+    }
+
+
+    /**
+     * @brief This auxiliary function takes ownership of a square adjacency matrix and updates the graph's properties.
+     * 
+     * @param matrix The matrix to adopt (left empty).
+     */
+    void Graph::adoptMatrix(vector<vector<int>>& matrix)
+    {
+        (*this)._adjacencyMatrix.clear();
+        (*this)._adjacencyMatrix.swap(matrix);
+        (*this)._numVertices = (*this)._adjacencyMatrix.size();
+        (*this)._storage = Storage::OwnedDense;
+        (*this)._denseData = nullptr;
+        (*this)._denseStride = 0;
+        (*this)._backing.reset();
+        invalidateIndexes();
+
+        // Check if the graph is directed or not
+        (*this)._isDirected = checkDirected();
+
+        // Count the number of edges based on graph type
+        (*this)._numEdges = countEdges();
+    }
+
+
+    /**
+     * @brief This auxiliary function drops all lazily built indexes of the graph.
+     */
+    void Graph::invalidateIndexes()
+    {
+        // In sparse storage the CSR index holds the edges themselves
+        if ((*this)._storage != Storage::Sparse)
+        {
+            (*this)._outEdges.reset();
+        }
+        (*this)._inEdges.reset();
+        (*this)._weightRange.reset();
+        (*this)._landmarks.reset();
+        (*this)._hierarchy.reset();
+    }
+
+
+    /**
+     * @brief This auxiliary function returns the smallest and largest edge weights, and computes them if they are not cached yet.
+     * @return The pair (smallest weight, largest weight), or (0, 0) if the graph has no edges.
+     */
+    const pair<int, int>& Graph::getWeightRange() const
+    {
+        return (*this)._weightRange.get([this]()
+        {
+            const AdjacencyIndex& edges = getOutEdges();
+            size_t numEntries = edges.numEntries();
+            int minWeight = numEntries > 0 ? INT_MAX : 0;
+            int maxWeight = numEntries > 0 ? INT_MIN : 0;
+            for (size_t e = 0; e < numEntries; e++)
+            {
+                minWeight = min(minWeight, edges.weights[e]);
+                maxWeight = max(maxWeight, edges.weights[e]);
+            }
+            return shared_ptr<const pair<int, int>>(make_shared<pair<int, int>>(minWeight, maxWeight));
+        });
     }
-}
\ No newline at end of file
+}
@@ -6,11 +6,185 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <memory>
+#include <cstdint>
+#include <mutex>
+#include <atomic>
 
 using namespace std;
 
 namespace ariel {
 
+class LandmarkIndex;
+class ContractionHierarchy;
+
+
+/**
+* @brief This struct represents a weighted edge source->target, used to build sparse graphs.
+*/
+struct Edge
+{
+    size_t source;      // The source vertex of the edge
+    size_t target;      // The target vertex of the edge
+    int weight;         // The weight of the edge (0 means no edge)
+};
+
+
+/**
+* @brief This struct represents a non-owning view of a row-major adjacency matrix held by the caller
+* (e.g. in shared memory or in a numpy array).
+*/
+struct GraphView
+{
+    const int* data;            // A pointer to the first weight of row 0
+    size_t numVertices;         // The number of vertices (rows and columns)
+    size_t stride;              // The distance (in elements) between the beginnings of two consecutive rows
+};
+
+
+/**
+* @brief This struct represents a read-only compressed sparse row (CSR) index of the edges of a graph.
+*
+* The edges leaving vertex u are stored at positions offsets[u] .. offsets[u + 1] - 1 of targets and weights, sorted by target.
+* The arrays either point into the storage vectors of the index itself, or into external memory (e.g. a memory-mapped
+* graph file) that is kept alive by the backing pointer.
+*/
+struct AdjacencyIndex
+{
+    size_t numVertices = 0;                 // The number of vertices covered by the index
+    const size_t* offsets = nullptr;        // numVertices + 1 offsets into targets and weights
+    const uint32_t* targets = nullptr;      // The target vertex of each edge
+    const int* weights = nullptr;           // The weight of each edge
+
+    vector<size_t> offsetStorage;           // Owned storage for offsets (empty when the arrays live in external memory)
+    vector<uint32_t> targetStorage;         // Owned storage for targets
+    vector<int> weightStorage;              // Owned storage for weights
+    shared_ptr<const void> backing;         // Keeps external memory alive as long as the index is in use
+
+    AdjacencyIndex() = default;
+    AdjacencyIndex(const AdjacencyIndex&) = delete;
+    AdjacencyIndex& operator=(const AdjacencyIndex&) = delete;
+
+
+    /**
+     * @brief This method points the arrays of the index to its own storage vectors.
+     */
+    void adoptStorage();
+
+
+    /**
+     * @brief This method returns the number of edges stored in the index.
+     * @return The number of (directed) entries.
+     */
+    size_t numEntries() const;
+
+
+    /**
+     * @brief This method returns the number of edges leaving a vertex.
+     * @param vertex The vertex.
+     * @return The out-degree of the vertex.
+     */
+    size_t degree(size_t vertex) const;
+
+
+    /**
+     * @brief This method finds the weight of the edge source->target by binary search.
+     * @param source The source vertex.
+     * @param target The target vertex.
+     * @return The weight of the edge, or 0 if there is no such edge.
+     */
+    int findWeight(size_t source, size_t target) const;
+};
+
+
+/**
+* @brief This class holds an object that is built on first use (e.g. an index of a graph) and then shared read-only.
+*
+* Several threads may request the object at once: the first request builds it under a lock, and later requests only
+* read an atomic flag. A copy shares the object (if it was built) but has its own lock.
+*/
+template <typename T>
+class LazyCache
+{
+    private:
+        mutable mutex _lock;            // Serializes the builds and the copies of the object
+        atomic<bool> _isBuilt;          // Set (with release order) once _value holds the object
+        shared_ptr<const T> _value;     // The object, or nullptr if it was not built yet
+
+    public:
+        LazyCache() : _isBuilt(false) {}
+
+        LazyCache(const LazyCache& other) : _isBuilt(false)
+        {
+            reset(other.share());
+        }
+
+        LazyCache& operator=(const LazyCache& other)
+        {
+            if (this != &other)
+            {
+                reset(other.share());
+            }
+            return *this;
+        }
+
+
+        /**
+         * @brief This method returns the object, and builds it first if it was not built yet.
+         * @param build A function that builds the object and returns it as a shared_ptr<const T>.
+         * @return A reference to the object, valid until the cache is reset.
+         */
+        template <typename Builder>
+        const T& get(const Builder& build)
+        {
+            if (!_isBuilt.load(memory_order_acquire))
+            {
+                lock_guard<mutex> guard(_lock);
+                if (!_value)
+                {
+                    _value = build();
+                    _isBuilt.store(true, memory_order_release);
+                }
+            }
+            return *_value;
+        }
+
+
+        /**
+         * @brief This method checks if the object was built.
+         * @return true if the object exists; otherwise, false.
+         */
+        bool isBuilt() const
+        {
+            return _isBuilt.load(memory_order_acquire);
+        }
+
+
+        /**
+         * @brief This method returns a shared pointer to the object.
+         * @return The object, or nullptr if it was not built yet.
+         */
+        shared_ptr<const T> share() const
+        {
+            lock_guard<mutex> guard(_lock);
+            return _value;
+        }
+
+
+        /**
+         * @brief This method replaces the object (e.g. drops it when it became stale).
+         * @note The caller must make sure that no other thread uses the cache at the same time.
+         * @param value The new object, or nullptr to drop it.
+         */
+        void reset(shared_ptr<const T> value = nullptr)
+        {
+            lock_guard<mutex> guard(_lock);
+            _value = value;
+            _isBuilt.store(static_cast<bool>(_value), memory_order_release);
+        }
+};
+
+
 /**
 * @This class represents a graph by using an adjacency matrix.
 */
@@ -19,10 +193,30 @@ class Graph
 
     // Private attributes and functions
     private:
+
+        /**
+         * @brief The ways the edges of a graph can be stored.
+         */
+        enum class Storage
+        {
+            OwnedDense,         // An adjacency matrix owned by the graph (_adjacencyMatrix)
+            ExternalDense,      // A row-major adjacency matrix in external memory (_denseData)
+            Sparse              // A CSR index only (_outEdges)
+        };
+
         vector<vector<int>> _adjacencyMatrix;   // A variable that stores the adjacency matrix that representing a graph
         size_t _numVertices;                    // A variable that stores the number of vertices in the graph
         size_t _numEdges;                       // A variable that stores the  number of edges in the graph
         bool _isDirected;                       // A flag that indicates if the graph is directed or undirected
+        Storage _storage;                       // A variable that stores where the edges of the graph live
+        const int* _denseData;                  // A pointer to an external row-major adjacency matrix (ExternalDense only)
+        size_t _denseStride;                    // The distance (in elements) between two rows of _denseData
+        shared_ptr<const void> _backing;        // Keeps the external memory of _denseData alive (e.g. a file mapping)
+        mutable LazyCache<AdjacencyIndex> _outEdges;       // The CSR index of the edges (built lazily for dense storage)
+        mutable LazyCache<AdjacencyIndex> _inEdges;        // The CSR index of the reversed edges (built lazily, directed graphs only)
+        mutable LazyCache<pair<int, int>> _weightRange;    // The smallest and largest edge weights (computed lazily)
+        mutable LazyCache<LandmarkIndex> _landmarks;       // The ALT landmark index (built on request)
+        mutable LazyCache<ContractionHierarchy> _hierarchy;    // The contraction hierarchy (built on request)
 
 
         /**
@@ -57,6 +251,83 @@ class Graph
         bool compareMagnitude(const Graph& other) const;
 
 
+        /**
+         * @brief This auxiliary function returns a pointer to a row of a densely stored graph.
+         *
+         * @param vertex The row to return.
+         * @return A pointer to the numVertices weights of the row, or nullptr if the graph is stored sparsely.
+         */
+        const int* denseRow(size_t vertex) const;
+
+
+        /**
+         * @brief This auxiliary function checks if the adjacency matrix of the graph is square.
+         * @return True if the matrix is square, otherwise false.
+         */
+        bool isSquare() const;
+
+
+        /**
+         * @brief This auxiliary function converts the graph to an owned adjacency matrix so it can be modified in place.
+         * Cached indexes are dropped, since they are about to become stale.
+         */
+        void materialize();
+
+
+        /**
+         * @brief This auxiliary function drops all lazily built indexes of the graph.
+         */
+        void invalidateIndexes();
+
+
+        /**
+         * @brief This auxiliary function returns the smallest and largest edge weights, and computes them if they are not cached yet.
+         * @return The pair (smallest weight, largest weight), or (0, 0) if the graph has no edges.
+         */
+        const pair<int, int>& getWeightRange() const;
+
+
+        /**
+         * @brief This auxiliary function takes ownership of a square adjacency matrix and updates the graph's properties.
+         * @param matrix The matrix to adopt (left empty).
+         */
+        void adoptMatrix(vector<vector<int>>& matrix);
+
+
+        /**
+         * @brief This auxiliary function writes the graph in the binary graph format to a file descriptor.
+         *
+         * @param fd The file descriptor to write to.
+         * @param withIndexes true to always write the CSR layout, followed by the reversed edges of a directed graph, so that
+         * a graph mapping the image never builds an index of its own; false to write the smaller layout only.
+         * @throws If writing fails throw runtime_error exception
+         */
+        void writeImage(int fd, bool withIndexes) const;
+
+
+        /**
+         * @brief This auxiliary function maps a binary graph image read-only and creates a graph on top of it.
+         *
+         * @param fd A descriptor of the file or shared memory segment that holds the image (closed by this function).
+         * @param source The name of the file or segment, for error messages.
+         * @return A graph that reads its edges directly from the mapping.
+         * @throws If the image cannot be mapped throw runtime_error exception, if it is malformed throw invalid_argument exception
+         */
+        static Graph mapImage(int fd, const string& source);
+
+
+        /**
+         * @brief This auxiliary function creates a graph on top of a binary graph image without copying it.
+         *
+         * @param image A pointer to the beginning of the image.
+         * @param length The size of the image in bytes.
+         * @param backing The owner of the image memory, kept alive by the returned graph.
+         * @return A graph that reads its edges directly from the image.
+         * @throws If the image is malformed throw invalid_argument exception
+         */
+        static Graph fromImage(const char* image, size_t length, const shared_ptr<const void>& backing);
+
+
     // Public methods 
     public:
 
@@ -66,6 +337,19 @@ class Graph
         Graph();
 
 
+        /**
+         * @brief A constructor that wraps a caller-owned adjacency matrix without copying it.
+         *
+         * The conversion is explicit: wrapping a view scans the matrix once (to count the edges and check the direction),
+         * and the first algorithm run on the graph builds its CSR index. Wrap a view once and reuse the graph for every query.
+         * @note The buffer must outlive the graph and must not change while the graph is in use. Modifying the graph
+         * (e.g. with operator*=) first copies the matrix, so the buffer itself is never written.
+         * @param view The view of the matrix.
+         * @throws If the view is empty or its stride is shorter than a row throw invalid_argument exception
+         */
+        explicit Graph(const GraphView& view);
+
+
         /**
          * @brief This method loads a graph from an adjacency matrix.
          * @param matrix The adjacency matrix representing the graph.
@@ -74,6 +358,124 @@ class Graph
         void loadGraph(vector<vector<int>>& matrix);
 
 
+        /**
+         * @brief This method loads a graph from a text file that holds an adjacency matrix, one row per line.
+         *
+         * Values may be separated by whitespace, commas or brackets, so the output of printGraph() can be loaded back.
+         * The file is memory-mapped and parsed by several threads with a hand-rolled integer parser.
+         * @param path The path of the file.
+         * @throws If the file cannot be read throw runtime_error exception, if the matrix is empty, not square or
+         * malformed throw invalid_argument exception
+         */
+        void loadMatrixFile(const string& path);
+
+
+        /**
+         * @brief This method loads a graph from a text file that holds a weighted edge list, one "u v w" line per edge.
+         *
+         * The number of vertices is the largest vertex index plus one, and the edges are stored sparsely.
+         * Empty lines and lines starting with '#' or '%' are skipped. The file is parsed like in loadMatrixFile().
+         * @param path The path of the file.
+         * @throws If the file cannot be read throw runtime_error exception, if it has no edges or is malformed throw
+         * invalid_argument exception
+         */
+        void loadEdgeListFile(const string& path);
+
+
+        /**
+         * @brief This method loads a graph from a Matrix Market (.mtx) coordinate file.
+         *
+         * Integer, real (with integral values) and pattern (every entry is an edge of weight 1) fields are supported.
+         * A symmetric matrix stores only one triangle; the mirrored entries are added, so the graph is undirected.
+         * The edges are stored sparsely, so the memory used is proportional to the number of entries. Entries with value 0
+         * are not edges and are ignored.
+         * @param path The path of the file.
+         * @throws If the file cannot be read throw runtime_error exception, if it is not a square coordinate matrix, is
+         * malformed, does not have the declared number of entries or has an entry twice throw invalid_argument exception
+         */
+        void loadMatrixMarketFile(const string& path);
+
+
+        /**
+         * @brief This method saves the graph to a Matrix Market (.mtx) coordinate file with integer weights.
+         *
+         * Only the edges are written. An undirected graph is written as a symmetric matrix (its lower triangle only).
+         * @param path The path of the file.
+         * @throws If the file cannot be written throw runtime_error exception
+         */
+        void saveMatrixMarketFile(const string& path) const;
+
+
+        /**
+         * @brief This method builds a graph in sparse storage directly from a list of edges, without an adjacency matrix.
+         *
+         * Edges with weight 0 are ignored, and if an edge appears more than once the last occurrence wins.
+         * @param numVertices The number of vertices.
+         * @param edges The edges of the graph.
+         * @return The resulting graph.
+         * @throws If there are no vertices or an edge has an invalid vertex throw invalid_argument exception
+         */
+        static Graph fromEdges(size_t numVertices, const vector<Edge>& edges);
+
+
+        /**
+         * @brief This method saves the graph to a file in the binary graph format.
+         *
+         * The file starts with a versioned header (number of vertices and edges, directed flag and weight type) followed by
+         * either a dense adjacency matrix or a CSR payload, whichever is smaller.
+         * @param path The path of the file.
+         * @throws If the file cannot be written throw runtime_error exception
+         */
+        void save(const string& path) const;
+
+
+        /**
+         * @brief This method opens a graph saved by save() by memory-mapping the file.
+         *
+         * The graph reads its edges directly from the mapping without copying them; opening only validates the CSR offsets and
+         * targets of a sparse image once (time complexity: O(V+E)).
+         * @param path The path of the file.
+         * @return The graph stored in the file.
+         * @throws If the file cannot be read throw runtime_error exception, if it is not a valid graph file throw invalid_argument exception
+         */
+        static Graph open(const string& path);
+
+
+        /**
+         * @brief This method publishes the graph in a POSIX shared memory segment, in the binary graph format.
+         *
+         * Other processes can then attach() to the segment and share a single physical copy of the graph. The segment always
+         * holds the CSR index of the edges, and of the reversed edges for a directed graph, so the attached graphs never build
+         * private indexes (a dense graph takes 8 bytes per edge instead of 4 per matrix cell). An existing segment with the
+         * same name is replaced; processes that already attached to it keep their (old) copy.
+         * @param name The name of the segment (a leading '/' is added if missing).
+         * @throws If the segment cannot be created or written throw runtime_error exception
+         */
+        void publish(const string& name) const;
+
+
+        /**
+         * @brief This method attaches to a graph published by publish(), mapping its segment read-only.
+         *
+         * The graph reads its edges directly from the shared segment, so attaching does not copy the graph (it is
+         * validated like in open()).
+         * @param name The name of the segment (a leading '/' is added if missing).
+         * @return The published graph.
+         * @throws If the segment does not exist throw runtime_error exception, if it does not hold a valid graph image
+         * (e.g. it is still being published) throw invalid_argument exception
+         */
+        static Graph attach(const string& name);
+
+
+        /**
+         * @brief This method removes a segment created by publish(). Attached graphs stay valid until they are destroyed.
+         *
+         * @param name The name of the segment (a leading '/' is added if missing).
+         * @throws If the segment does not exist throw runtime_error exception
+         */
+        static void unpublish(const string& name);
+
+
         /**
          * @brief This method prints the number of vertices and edges in the graph.
          */
@@ -94,6 +496,24 @@ class Graph
         size_t getNumEdges() const;
 
 
+        /**
+         * @brief This method returns the smallest weight of an edge in the graph.
+         *
+         * The weight range is computed on the first call and cached until the graph is modified.
+         * @return The smallest weight, or 0 if the graph has no edges.
+         */
+        int getMinWeight() const;
+
+
+        /**
+         * @brief This method returns the largest weight of an edge in the graph.
+         *
+         * The weight range is computed on the first call and cached until the graph is modified.
+         * @return The largest weight, or 0 if the graph has no edges.
+         */
+        int getMaxWeight() const;
+
+
         /**
          * @brief This method returns if the graph is directed or not.
          * @return True if the graph is directed, false otherwise.
@@ -101,9 +521,96 @@ class Graph
         bool isGraphDirected() const;
 
 
+        /**
+         * @brief This method returns the weight of the edge u->v.
+         * @param vertex_u The source vertex.
+         * @param vertex_v The target vertex.
+         * @return The weight of the edge, or 0 if there is no such edge.
+         */
+        int getEdgeWeight(size_t vertex_u, size_t vertex_v) const;
+
+
+        /**
+         * @brief This method returns the CSR index of the edges leaving each vertex.
+         *
+         * For densely stored graphs the index is built on the first call and cached until the graph is modified.
+         * @note Several threads may call this method at once; the index is built only once.
+         * @return A reference to the index.
+         */
+        const AdjacencyIndex& getOutEdges() const;
+
+
+        /**
+         * @brief This method returns the CSR index of the edges entering each vertex (row v lists the sources of the edges u->v).
+         *
+         * For undirected graphs this is the out-edge index itself; otherwise it is built on the first call and cached until
+         * the graph is modified.
+         * @note Several threads may call this method at once; the index is built only once.
+         * @return A reference to the index.
+         */
+        const AdjacencyIndex& getInEdges() const;
+
+
+        /**
+         * @brief This method returns a pointer to a row of the adjacency matrix of a densely stored graph.
+         *
+         * @param vertex The row to return.
+         * @return A pointer to the numVertices weights of the row, or nullptr if the graph is stored sparsely.
+         */
+        const int* getDenseRow(size_t vertex) const;
+
+
+        /**
+         * @brief This method returns the ALT landmark index of the graph, used to speed up repeated shortest path queries.
+         *
+         * The index is built on the first call (two Dijkstra searches per landmark) and cached until the graph is modified.
+         * It is never built implicitly; once it exists, shortestPath() uses it.
+         * @note Several threads may call this method at once; the index is built only once.
+         * @return A reference to the index.
+         * @throws If the graph has negative weights throw invalid_argument exception
+         */
+        const LandmarkIndex& getLandmarks() const;
+
+
+        /**
+         * @brief This method checks if the landmark index of the graph is already built.
+         * @return true if the index is cached; otherwise, false.
+         */
+        bool hasLandmarks() const;
+
+
+        /**
+         * @brief This method returns the contraction hierarchy of the graph, used to answer shortest path queries quickly.
+         *
+         * The hierarchy is built on the first call and cached until the graph is modified. Building it takes minutes on
+         * graphs with millions of vertices, so it is never built implicitly; once it exists, shortestPath() uses it.
+         * @note Several threads may call this method at once; the hierarchy is built only once.
+         * @return A reference to the hierarchy.
+         * @throws If the graph has negative weights throw invalid_argument exception
+         */
+        const ContractionHierarchy& getContractionHierarchy() const;
+
+
+        /**
+         * @brief This method attaches a hierarchy that was built earlier (e.g. loaded from a file) to the graph.
+         *
+         * @param hierarchy The hierarchy.
+         * @throws If the hierarchy was built for a different graph throw invalid_argument exception
+         */
+        void setContractionHierarchy(ContractionHierarchy hierarchy);
+
+
+        /**
+         * @brief This method checks if the graph has a contraction hierarchy.
+         * @return true if the hierarchy is cached; otherwise, false.
+         */
+        bool hasContractionHierarchy() const;
+
+
         /**
          * @brief This method returns the adjacency matrix of the graph. 
          * A 2D array represented by vetcor of vectors.
+         * @note A graph backed by external memory or sparse storage is first converted to an owned matrix.
          * @return A reference to the adjacency matrix.
          */
         vector<vector<int>>& getAdjacencyMatrix();
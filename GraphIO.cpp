@@ -0,0 +1,1198 @@
+// Email: origoldbsc@gmail.com
+
+#include "Graph.hpp"
+#include "Parallel.hpp"
+#include <stdexcept>
+#include <climits>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace ariel {
+
+    /*********************************************/
+    ///           BINARY GRAPH FORMAT           ///
+    /*********************************************/
+
+    namespace {
+
+        const char IMAGE_MAGIC[8] = {'A', 'R', 'G', 'R', 'A', 'P', 'H', '\0'};     // Identifies a binary graph file
+        const uint32_t IMAGE_VERSION = 1;               // The current version of the format
+        const uint32_t LAYOUT_DENSE = 0;                // The payload is a row-major V*V matrix of int32 weights
+        const uint32_t LAYOUT_CSR = 1;                  // The payload is uint64 offsets[V+1], uint32 targets[N], int32 weights[N]
+        const uint32_t WEIGHT_INT32 = 1;                // Weights are stored as 32-bit signed integers
+        const uint32_t FLAG_DIRECTED = 1;               // The graph is directed
+        const uint32_t FLAG_REVERSE_CSR = 2;            // The CSR payload is followed by the CSR of the reversed edges
+        const size_t WRITE_BUFFER_SIZE = 1 << 20;       // The size of the buffer used when writing an image
+
+        /**
+         * @brief The header at the beginning of every binary graph image.
+         *
+         * All fields are stored in host byte order, so images are not portable between machines of different endianness.
+         */
+        struct ImageHeader
+        {
+            char magic[8];              // IMAGE_MAGIC
+            uint32_t version;           // IMAGE_VERSION
+            uint32_t layout;            // LAYOUT_DENSE or LAYOUT_CSR
+            uint32_t weightType;        // WEIGHT_INT32
+            uint32_t flags;             // FLAG_DIRECTED if the graph is directed, FLAG_REVERSE_CSR if it has the reversed edges
+            uint64_t numVertices;       // The number of vertices
+            uint64_t numEdges;          // The number of edges, as reported by getNumEdges()
+            uint64_t numEntries;        // The number of stored CSR entries (0 for the dense layout)
+            uint64_t reserved[2];       // Pads the header to 64 bytes, so the payload stays aligned
+        };
+
+        static_assert(sizeof(ImageHeader) == 64, "The binary graph header must be 64 bytes long");
+        static_assert(sizeof(size_t) == sizeof(uint64_t), "CSR offsets are mapped directly as size_t");
+
+
+        /**
+         * @brief This auxiliary class writes an image to a file descriptor through a large buffer.
+         */
+        class ImageWriter
+        {
+            private:
+                int _fd;                    // The file descriptor to write to
+                vector<char> _buffer;       // Pending bytes that were not written yet
+
+            public:
+                explicit ImageWriter(int fd) : _fd(fd)
+                {
+                    _buffer.reserve(WRITE_BUFFER_SIZE);
+                }
+
+                void write(const void* data, size_t length)
+                {
+                    const char* bytes = static_cast<const char*>(data);
+
+                    // Large blocks bypass the buffer
+                    if (length >= WRITE_BUFFER_SIZE)
+                    {
+                        flush();
+                        writeAll(bytes, length);
+                        return;
+                    }
+                    if (_buffer.size() + length > WRITE_BUFFER_SIZE)
+                    {
+                        flush();
+                    }
+                    _buffer.insert(_buffer.end(), bytes, bytes + length);
+                }
+
+                void flush()
+                {
+                    writeAll(_buffer.data(), _buffer.size());
+                    _buffer.clear();
+                }
+
+            private:
+                void writeAll(const char* bytes, size_t length)
+                {
+                    while (length > 0)
+                    {
+                        ssize_t written = ::write(_fd, bytes, length);
+                        if (written < 0)
+                        {
+                            if (errno == EINTR)
+                            {
+                                continue;
+                            }
+                            throw runtime_error(string("Cannot write graph image: ") + strerror(errno));
+                        }
+                        bytes += written;
+                        length -= static_cast<size_t>(written);
+                    }
+                }
+        };
+
+
+        /**
+         * @brief This auxiliary function creates a CSR index on top of a section of a binary graph image and validates it.
+         *
+         * The image comes from a file, so every offset and target is checked once (time complexity: O(V+N)); a corrupt
+         * or truncated image is rejected here instead of being read out of bounds by the algorithms.
+         *
+         * @param section A pointer to the section: uint64 offsets[V+1], uint32 targets[N], int32 weights[N].
+         * @param sectionLength The number of bytes of the image from the beginning of the section.
+         * @param numVertices The number of vertices (at most UINT32_MAX).
+         * @param numEntries The number of entries.
+         * @param backing The owner of the image memory, kept alive by the index.
+         * @return The index.
+         * @throws If the section is truncated or inconsistent throw invalid_argument exception
+         */
+        shared_ptr<AdjacencyIndex> mapCsrSection(const char* section, size_t sectionLength, size_t numVertices, size_t numEntries,
+                                                 const shared_ptr<const void>& backing)
+        {
+            size_t offsetsLength = (numVertices + 1) * sizeof(uint64_t);
+            if (offsetsLength > sectionLength || numEntries > (sectionLength - offsetsLength) / (sizeof(uint32_t) + sizeof(int)))
+            {
+                throw invalid_argument("Invalid graph file: Truncated CSR payload");
+            }
+
+            shared_ptr<AdjacencyIndex> index = make_shared<AdjacencyIndex>();
+            index->numVertices = numVertices;
+            index->offsets = reinterpret_cast<const size_t*>(section);
+            index->targets = reinterpret_cast<const uint32_t*>(section + offsetsLength);
+            index->weights = reinterpret_cast<const int*>(section + offsetsLength + numEntries * sizeof(uint32_t));
+            index->backing = backing;
+
+            // The offsets must split exactly the stored entries into rows, and every target must be a vertex
+            if (index->offsets[0] != 0 || index->offsets[numVertices] != numEntries)
+            {
+                throw invalid_argument("Invalid graph file: Inconsistent CSR offsets");
+            }
+            for (size_t i = 0; i < numVertices; i++)
+            {
+                if (index->offsets[i] > index->offsets[i + 1])
+                {
+                    throw invalid_argument("Invalid graph file: Inconsistent CSR offsets");
+                }
+            }
+            for (size_t e = 0; e < numEntries; e++)
+            {
+                if (index->targets[e] >= numVertices)
+                {
+                    throw invalid_argument("Invalid graph file: Invalid vertex " + to_string(index->targets[e]));
+                }
+            }
+            return index;
+        }
+
+
+        /*********************************************/
+        ///              TEXT PARSING               ///
+        /*********************************************/
+
+        const size_t PARSE_CHUNK_SIZE = 1 << 20;        // The minimal number of bytes worth parsing on a separate thread
+
+        /**
+         * @brief This auxiliary class maps a text file read-only into memory for the duration of parsing.
+         */
+        class MappedText
+        {
+            private:
+                const char* _data;          // The content of the file
+                size_t _length;             // The size of the file in bytes
+
+            public:
+                explicit MappedText(const string& path) : _data(nullptr), _length(0)
+                {
+                    int fd = ::open(path.c_str(), O_RDONLY);
+                    if (fd < 0)
+                    {
+                        throw runtime_error("Cannot open " + path + ": " + strerror(errno));
+                    }
+                    struct stat info;
+                    if (fstat(fd, &info) != 0)
+                    {
+                        ::close(fd);
+                        throw runtime_error("Cannot stat " + path + ": " + strerror(errno));
+                    }
+                    _length = static_cast<size_t>(info.st_size);
+                    if (_length > 0)
+                    {
+                        void* address = mmap(nullptr, _length, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (address == MAP_FAILED)
+                        {
+                            ::close(fd);
+                            throw runtime_error("Cannot map " + path + ": " + strerror(errno));
+                        }
+                        madvise(address, _length, MADV_SEQUENTIAL);
+                        _data = static_cast<const char*>(address);
+                    }
+                    ::close(fd);
+                }
+
+                ~MappedText()
+                {
+                    if (_data != nullptr)
+                    {
+                        munmap(const_cast<char*>(_data), _length);
+                    }
+                }
+
+                MappedText(const MappedText&) = delete;
+                MappedText& operator=(const MappedText&) = delete;
+
+                const char* begin() const { return _data; }
+                const char* end() const { return _data + _length; }
+                size_t length() const { return _length; }
+        };
+
+
+        /**
+         * @brief This auxiliary function splits a text into chunks that start at the beginning of a line.
+         *
+         * @param begin The beginning of the text.
+         * @param end The end of the text.
+         * @return The start of each chunk, followed by the end of the text.
+         */
+        vector<const char*> splitLines(const char* begin, const char* end)
+        {
+            size_t length = static_cast<size_t>(end - begin);
+            size_t numChunks = max<size_t>(1, min(Parallel::getNumThreads(), length / PARSE_CHUNK_SIZE));
+            vector<const char*> bounds(1, begin);
+            for (size_t i = 1; i < numChunks; i++)
+            {
+                const char* cut = max(bounds.back(), begin + length * i / numChunks);
+                const char* newline = static_cast<const char*>(memchr(cut, '\n', static_cast<size_t>(end - cut)));
+                bounds.push_back(newline == nullptr ? end : newline + 1);
+            }
+            bounds.push_back(end);
+            return bounds;
+        }
+
+
+        /**
+         * @brief This auxiliary function finds the end of the line that starts at a given position.
+         *
+         * @param cursor The beginning of the line.
+         * @param end The end of the text.
+         * @return A pointer to the '\n' that ends the line, or end.
+         */
+        const char* lineEnd(const char* cursor, const char* end)
+        {
+            const char* newline = static_cast<const char*>(memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+            return newline == nullptr ? end : newline;
+        }
+
+
+        /**
+         * @brief This auxiliary function returns the beginning of the line that follows a line end.
+         *
+         * @param lineEnd The end of the current line, as returned by lineEnd().
+         * @param end The end of the text.
+         * @return The beginning of the next line, or end.
+         */
+        const char* nextLine(const char* lineEnd, const char* end)
+        {
+            return lineEnd < end ? lineEnd + 1 : end;
+        }
+
+
+        /**
+         * @brief This auxiliary function checks if a character separates values in a text graph file.
+         */
+        bool isSeparator(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == '[' || c == ']' || c == ';';
+        }
+
+
+        /**
+         * @brief This auxiliary function parses the next integer of a line, skipping separators before it.
+         *
+         * @param cursor The position to parse from, advanced past the integer.
+         * @param end The end of the line.
+         * @param value The parsed value.
+         * @return true if an integer was parsed, false if the line has no more values.
+         * @throws If the line holds something else than integers and separators, or the integer does not fit in a
+         * long long, throw invalid_argument exception
+         */
+        bool parseInteger(const char*& cursor, const char* end, long long& value)
+        {
+            while (cursor < end && isSeparator(*cursor))
+            {
+                cursor++;
+            }
+            if (cursor == end)
+            {
+                return false;
+            }
+
+            bool negative = *cursor == '-';
+            if (*cursor == '-' || *cursor == '+')
+            {
+                cursor++;
+            }
+            if (cursor == end || *cursor < '0' || *cursor > '9')
+            {
+                throw invalid_argument("Invalid graph file: Expected a number");
+            }
+
+            unsigned long long magnitude = 0;
+            while (cursor < end && *cursor >= '0' && *cursor <= '9')
+            {
+                magnitude = magnitude * 10 + static_cast<unsigned long long>(*cursor - '0');
+                if (magnitude > static_cast<unsigned long long>(LLONG_MAX))
+                {
+                    throw invalid_argument("Invalid graph file: Value out of range");
+                }
+                cursor++;
+            }
+            if (cursor < end && !isSeparator(*cursor))
+            {
+                throw invalid_argument("Invalid graph file: Unexpected character '" + string(1, *cursor) + "'");
+            }
+
+            value = negative ? -static_cast<long long>(magnitude) : static_cast<long long>(magnitude);
+            return true;
+        }
+
+
+        /**
+         * @brief This auxiliary function converts a parsed value to an edge weight.
+         *
+         * @param value The parsed value.
+         * @return The value as an int.
+         * @throws If the value does not fit in an int throw invalid_argument exception
+         */
+        int toWeight(long long value)
+        {
+            if (value < INT_MIN || value > INT_MAX)
+            {
+                throw invalid_argument("Invalid graph file: Weight " + to_string(value) + " is out of range");
+            }
+            return static_cast<int>(value);
+        }
+
+
+        /**
+         * @brief This auxiliary function checks if a line holds no values (only separators, or a comment).
+         */
+        bool isBlankLine(const char* cursor, const char* end)
+        {
+            while (cursor < end && isSeparator(*cursor))
+            {
+                cursor++;
+            }
+            return cursor == end || *cursor == '#' || *cursor == '%';
+        }
+
+
+        /**
+         * @brief This auxiliary function parses a fixed number of integers from a line.
+         *
+         * @param cursor The position to parse from, advanced past the integers.
+         * @param end The end of the line.
+         * @param values The parsed values.
+         * @param count The number of values to parse.
+         * @param allowMore true if the line may hold more values after them.
+         * @return true if the line holds exactly count values (or at least count, if allowMore is set).
+         */
+        bool parseFields(const char*& cursor, const char* end, long long* values, size_t count, bool allowMore = false)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                if (!parseInteger(cursor, end, values[i]))
+                {
+                    return false;
+                }
+            }
+            long long extra = 0;
+            const char* rest = cursor;
+            return allowMore || !parseInteger(rest, end, extra);
+        }
+
+
+        /**
+         * @brief This auxiliary function converts a parsed value to a vertex index.
+         *
+         * @param value The parsed value.
+         * @param base The index of the first vertex in the file (0 or 1).
+         * @return The 0-based index of the vertex.
+         * @throws If the value is not a valid vertex index throw invalid_argument exception
+         */
+        size_t toVertex(long long value, long long base)
+        {
+            if (value < base || value - base >= static_cast<long long>(UINT32_MAX))
+            {
+                throw invalid_argument("Invalid graph file: Vertex " + to_string(value) + " is out of range");
+            }
+            return static_cast<size_t>(value - base);
+        }
+
+
+        /**
+         * @brief This auxiliary function parses the integer weight that remains on a line.
+         *
+         * @param cursor The position to parse from.
+         * @param end The end of the line.
+         * @return The weight.
+         * @throws If the line does not hold exactly one more integer throw invalid_argument exception
+         */
+        int parseWeight(const char* cursor, const char* end)
+        {
+            long long value = 0;
+            if (!parseFields(cursor, end, &value, 1))
+            {
+                throw invalid_argument("Invalid graph file: Expected a single weight");
+            }
+            return toWeight(value);
+        }
+
+
+        /**
+         * @brief This auxiliary function parses the real weight that remains on a line, which must have an integral value.
+         *
+         * @param cursor The position to parse from.
+         * @param end The end of the line.
+         * @return The weight.
+         * @throws If the line does not hold exactly one more number, or it is not an integer, throw invalid_argument exception
+         */
+        int parseIntegralReal(const char* cursor, const char* end)
+        {
+            while (cursor < end && isSeparator(*cursor))
+            {
+                cursor++;
+            }
+            const char* tokenEnd = cursor;
+            while (tokenEnd < end && !isSeparator(*tokenEnd))
+            {
+                tokenEnd++;
+            }
+
+            char token[64];
+            size_t length = static_cast<size_t>(tokenEnd - cursor);
+            if (length == 0 || length >= sizeof(token) || !isBlankLine(tokenEnd, end))
+            {
+                throw invalid_argument("Invalid graph file: Expected a single weight");
+            }
+            memcpy(token, cursor, length);
+            token[length] = '\0';
+
+            char* parsedEnd = nullptr;
+            double value = strtod(token, &parsedEnd);
+            if (parsedEnd != token + length || value != floor(value))
+            {
+                throw invalid_argument("Invalid graph file: Weight " + string(token) + " is not an integer");
+            }
+            if (value < INT_MIN || value > INT_MAX)
+            {
+                throw invalid_argument("Invalid graph file: Weight " + string(token) + " is out of range");
+            }
+            return static_cast<int>(value);
+        }
+
+
+        /**
+         * @brief This auxiliary function writes the decimal representation of an integer.
+         *
+         * @param output The buffer to write to (at least 20 characters).
+         * @param value The integer.
+         * @return The number of characters written.
+         */
+        size_t formatInteger(char* output, long long value)
+        {
+            char digits[20];
+            size_t count = 0;
+            size_t length = 0;
+            unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+            do
+            {
+                digits[count++] = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+
+            if (value < 0)
+            {
+                output[length++] = '-';
+            }
+            while (count > 0)
+            {
+                output[length++] = digits[--count];
+            }
+            return length;
+        }
+
+
+        /**
+         * @brief This auxiliary function parses the edge lines of a text in parallel.
+         *
+         * Every line gets edgesPerLine consecutive slots in the result, pre-sized from a first counting pass. Blank and
+         * comment lines leave their slots as zero-weight edges, which fromEdges() ignores.
+         * @param begin The beginning of the text.
+         * @param end The end of the text.
+         * @param edgesPerLine The number of edges a line can produce.
+         * @param parseLine The function that parses a non-blank line into its slots: (line, end of line, Edge* slots).
+         * @param numParsedLines If not null, filled with the number of non-blank lines that were parsed.
+         * @return The parsed edges.
+         */
+        template <typename LineParser>
+        vector<Edge> parseEdgeLines(const char* begin, const char* end, size_t edgesPerLine, const LineParser& parseLine,
+                                    size_t* numParsedLines = nullptr)
+        {
+            vector<const char*> bounds = splitLines(begin, end);
+            size_t numChunks = bounds.size() - 1;
+
+            // Pass 1: count the lines of every chunk to pre-size the edge array
+            vector<size_t> firstLine(numChunks + 1, 0);
+            Parallel::run(numChunks, [&bounds, &firstLine](size_t chunk)
+            {
+                size_t lines = 0;
+                for (const char* line = bounds[chunk]; line < bounds[chunk + 1]; line = nextLine(lineEnd(line, bounds[chunk + 1]), bounds[chunk + 1]))
+                {
+                    lines++;
+                }
+                firstLine[chunk + 1] = lines;
+            });
+            for (size_t chunk = 0; chunk < numChunks; chunk++)
+            {
+                firstLine[chunk + 1] += firstLine[chunk];
+            }
+
+            // Pass 2: parse every line into its slots
+            vector<Edge> edges(firstLine[numChunks] * edgesPerLine, Edge{0, 0, 0});
+            vector<size_t> parsedLines(numChunks, 0);
+            Parallel::run(numChunks, [&bounds, &firstLine, &edges, &parsedLines, edgesPerLine, &parseLine](size_t chunk)
+            {
+                size_t slot = firstLine[chunk] * edgesPerLine;
+                for (const char* line = bounds[chunk]; line < bounds[chunk + 1]; slot += edgesPerLine)
+                {
+                    const char* stop = lineEnd(line, bounds[chunk + 1]);
+                    if (!isBlankLine(line, stop))
+                    {
+                        parseLine(line, stop, &edges[slot]);
+                        parsedLines[chunk]++;
+                    }
+                    line = nextLine(stop, bounds[chunk + 1]);
+                }
+            });
+            if (numParsedLines != nullptr)
+            {
+                *numParsedLines = 0;
+                for (size_t chunk = 0; chunk < numChunks; chunk++)
+                {
+                    *numParsedLines += parsedLines[chunk];
+                }
+            }
+            return edges;
+        }
+    }
+
+
+    /**
+     * @brief This method saves the graph to a file in the binary graph format.
+     *
+     * The file starts with a versioned header (number of vertices and edges, directed flag and weight type) followed by
+     * either a dense adjacency matrix or a CSR payload, whichever is smaller.
+     * @param path The path of the file.
+     * @throws If the file cannot be written throw runtime_error exception
+     */
+    void Graph::save(const string& path) const
+    {
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            throw runtime_error("Cannot open " + path + " for writing: " + strerror(errno));
+        }
+
+        try
+        {
+            writeImage(fd, false);
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+
+        if (::close(fd) != 0)
+        {
+            throw runtime_error("Cannot save graph to " + path + ": " + strerror(errno));
+        }
+    }
+
+
+    /**
+     * @brief This method opens a graph saved by save() by memory-mapping the file.
+     *
+     * The graph reads its edges directly from the mapping without copying them; opening only validates the CSR offsets and
+     * targets of a sparse image once (time complexity: O(V+E)).
+     * @param path The path of the file.
+     * @return The graph stored in the file.
+     * @throws If the file cannot be read throw runtime_error exception, if it is not a valid graph file throw invalid_argument exception
+     */
+    Graph Graph::open(const string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw runtime_error("Cannot open " + path + ": " + strerror(errno));
+        }
+        return mapImage(fd, path);
+    }
+
+
+    /**
+     * @brief This method publishes the graph in a POSIX shared memory segment, in the binary graph format.
+     *
+     * Other processes can then attach() to the segment and share a single physical copy of the graph. The segment always
+     * holds the CSR index of the edges, and of the reversed edges for a directed graph, so the attached graphs never build
+     * private indexes (a dense graph takes 8 bytes per edge instead of 4 per matrix cell). An existing segment with the
+     * same name is replaced; processes that already attached to it keep their (old) copy.
+     * @param name The name of the segment (a leading '/' is added if missing).
+     * @throws If the segment cannot be created or written throw runtime_error exception
+     */
+    void Graph::publish(const string& name) const
+    {
+        string segment = name.empty() || name[0] != '/' ? "/" + name : name;
+
+        // Unlinking first leaves the old segment intact for processes that still have it mapped
+        shm_unlink(segment.c_str());
+        int fd = shm_open(segment.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0)
+        {
+            throw runtime_error("Cannot create shared memory segment " + segment + ": " + strerror(errno));
+        }
+
+        try
+        {
+            writeImage(fd, true);
+        }
+        catch (...)
+        {
+            ::close(fd);
+            shm_unlink(segment.c_str());
+            throw;
+        }
+        ::close(fd);
+    }
+
+
+    /**
+     * @brief This method attaches to a graph published by publish(), mapping its segment read-only.
+     *
+     * The graph reads its edges directly from the shared segment, so attaching does not copy the graph (it is
+     * validated like in open()).
+     * @param name The name of the segment (a leading '/' is added if missing).
+     * @return The published graph.
+     * @throws If the segment does not exist throw runtime_error exception, if it does not hold a valid graph image
+     * (e.g. it is still being published) throw invalid_argument exception
+     */
+    Graph Graph::attach(const string& name)
+    {
+        string segment = name.empty() || name[0] != '/' ? "/" + name : name;
+        int fd = shm_open(segment.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+        {
+            throw runtime_error("Cannot open shared memory segment " + segment + ": " + strerror(errno));
+        }
+        return mapImage(fd, segment);
+    }
+
+
+    /**
+     * @brief This method removes a segment created by publish(). Attached graphs stay valid until they are destroyed.
+     *
+     * @param name The name of the segment (a leading '/' is added if missing).
+     * @throws If the segment does not exist throw runtime_error exception
+     */
+    void Graph::unpublish(const string& name)
+    {
+        string segment = name.empty() || name[0] != '/' ? "/" + name : name;
+        if (shm_unlink(segment.c_str()) != 0)
+        {
+            throw runtime_error("Cannot remove shared memory segment " + segment + ": " + strerror(errno));
+        }
+    }
+
+
+    /**
+     * @brief This method loads a graph from a text file that holds an adjacency matrix, one row per line.
+     *
+     * Values may be separated by whitespace, commas or brackets, so the output of printGraph() can be loaded back.
+     * The file is memory-mapped and parsed by several threads with a hand-rolled integer parser.
+     * @param path The path of the file.
+     * @throws If the file cannot be read throw runtime_error exception, if the matrix is empty, not square or
+     * malformed throw invalid_argument exception
+     */
+    void Graph::loadMatrixFile(const string& path)
+    {
+        MappedText text(path);
+        vector<const char*> bounds = splitLines(text.begin(), text.end());
+        size_t numChunks = bounds.size() - 1;
+
+        // Pass 1: count the rows of every chunk, so each chunk knows the index of its first row
+        vector<size_t> firstRow(numChunks + 1, 0);
+        Parallel::run(numChunks, [&bounds, &firstRow](size_t chunk)
+        {
+            size_t rows = 0;
+            for (const char* line = bounds[chunk]; line < bounds[chunk + 1]; )
+            {
+                const char* end = lineEnd(line, bounds[chunk + 1]);
+                if (!isBlankLine(line, end))
+                {
+                    rows++;
+                }
+                line = nextLine(end, bounds[chunk + 1]);
+            }
+            firstRow[chunk + 1] = rows;
+        });
+        for (size_t chunk = 0; chunk < numChunks; chunk++)
+        {
+            firstRow[chunk + 1] += firstRow[chunk];
+        }
+
+        size_t numVertices = firstRow[numChunks];
+        if (numVertices == 0)
+        {
+            throw invalid_argument("Invalid graph: The graph matrix is empty");
+        }
+
+        // Pass 2: parse the rows straight into a pre-sized matrix
+        vector<vector<int>> matrix(numVertices);
+        Parallel::run(numChunks, [&bounds, &firstRow, &matrix, numVertices](size_t chunk)
+        {
+            size_t row = firstRow[chunk];
+            for (const char* line = bounds[chunk]; line < bounds[chunk + 1]; )
+            {
+                const char* end = lineEnd(line, bounds[chunk + 1]);
+                if (!isBlankLine(line, end))
+                {
+                    vector<int>& values = matrix[row++];
+                    values.resize(numVertices);
+                    size_t count = 0;
+                    long long value = 0;
+                    while (parseInteger(line, end, value))
+                    {
+                        if (count == numVertices)
+                        {
+                            throw invalid_argument("Invalid graph: The graph is not a square matrix");
+                        }
+                        values[count++] = toWeight(value);
+                    }
+                    if (count != numVertices)
+                    {
+                        throw invalid_argument("Invalid graph: The graph is not a square matrix");
+                    }
+                }
+                line = nextLine(end, bounds[chunk + 1]);
+            }
+        });
+
+        adoptMatrix(matrix);
+    }
+
+
+    /**
+     * @brief This method loads a graph from a text file that holds a weighted edge list, one "u v w" line per edge.
+     *
+     * The number of vertices is the largest vertex index plus one, and the edges are stored sparsely.
+     * Empty lines and lines starting with '#' or '%' are skipped. The file is parsed like in loadMatrixFile().
+     * @param path The path of the file.
+     * @throws If the file cannot be read throw runtime_error exception, if it has no edges or is malformed throw
+     * invalid_argument exception
+     */
+    void Graph::loadEdgeListFile(const string& path)
+    {
+        MappedText text(path);
+        vector<Edge> edges = parseEdgeLines(text.begin(), text.end(), 1, [](const char* line, const char* end, Edge* edge)
+        {
+            long long values[3];
+            const char* cursor = line;
+            if (!parseFields(cursor, end, values, 3))
+            {
+                throw invalid_argument("Invalid edge list: Expected \"u v w\" in \"" + string(line, end) + "\"");
+            }
+            edge->source = toVertex(values[0], 0);
+            edge->target = toVertex(values[1], 0);
+            edge->weight = toWeight(values[2]);
+        });
+
+        size_t numVertices = 0;
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            if (edges[i].weight != 0)
+            {
+                numVertices = max(numVertices, max(edges[i].source, edges[i].target) + 1);
+            }
+        }
+        if (numVertices == 0)
+        {
+            throw invalid_argument("Invalid graph: The graph matrix is empty");
+        }
+        *this = fromEdges(numVertices, edges);
+    }
+
+
+    /**
+     * @brief This method loads a graph from a Matrix Market (.mtx) coordinate file.
+     *
+     * Integer, real (with integral values) and pattern (every entry is an edge of weight 1) fields are supported.
+     * A symmetric matrix stores only one triangle; the mirrored entries are added, so the graph is undirected.
+     * The edges are stored sparsely, so the memory used is proportional to the number of entries. Entries with value 0
+     * are not edges and are ignored.
+     * @param path The path of the file.
+     * @throws If the file cannot be read throw runtime_error exception, if it is not a square coordinate matrix, is
+     * malformed, does not have the declared number of entries or has an entry twice throw invalid_argument exception
+     */
+    void Graph::loadMatrixMarketFile(const string& path)
+    {
+        MappedText text(path);
+        const char* line = text.begin();
+        const char* end = lineEnd(line, text.end());
+
+        // The banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+        istringstream banner(string(line, end));
+        string tag;
+        string object;
+        string format;
+        string field;
+        string symmetry;
+        banner >> tag >> object >> format >> field >> symmetry;
+        transform(object.begin(), object.end(), object.begin(), ::tolower);
+        transform(format.begin(), format.end(), format.begin(), ::tolower);
+        transform(field.begin(), field.end(), field.begin(), ::tolower);
+        transform(symmetry.begin(), symmetry.end(), symmetry.begin(), ::tolower);
+        if (tag != "%%MatrixMarket" || object != "matrix")
+        {
+            throw invalid_argument("Invalid Matrix Market file: Missing %%MatrixMarket matrix banner");
+        }
+        if (format != "coordinate")
+        {
+            throw invalid_argument("Invalid Matrix Market file: Only the coordinate format is supported");
+        }
+        if (field != "integer" && field != "real" && field != "pattern")
+        {
+            throw invalid_argument("Invalid Matrix Market file: Unsupported field " + field);
+        }
+        if (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric")
+        {
+            throw invalid_argument("Invalid Matrix Market file: Unsupported symmetry " + symmetry);
+        }
+
+        // Skip the comments up to the size line: <rows> <columns> <entries>
+        do
+        {
+            if (end == text.end())
+            {
+                throw invalid_argument("Invalid Matrix Market file: Missing size line");
+            }
+            line = nextLine(end, text.end());
+            end = lineEnd(line, text.end());
+        } while (isBlankLine(line, end));
+
+        long long size[3];
+        const char* cursor = line;
+        if (!parseFields(cursor, end, size, 3) || size[0] <= 0 || size[2] < 0)
+        {
+            throw invalid_argument("Invalid Matrix Market file: Malformed size line");
+        }
+        if (size[0] != size[1])
+        {
+            throw invalid_argument("Invalid graph: The graph is not a square matrix");
+        }
+        if (size[0] > static_cast<long long>(UINT32_MAX))
+        {
+            throw invalid_argument("Invalid graph: Too many vertices for sparse storage");
+        }
+
+        size_t numVertices = static_cast<size_t>(size[0]);
+        bool isPattern = field == "pattern";
+        bool isReal = field == "real";
+        bool isSymmetric = symmetry != "general";
+        int mirrorSign = symmetry == "skew-symmetric" ? -1 : 1;
+
+        // Every entry line produces its edge and, for symmetric matrices, the mirrored edge
+        size_t numEntries = 0;
+        vector<Edge> edges = parseEdgeLines(nextLine(end, text.end()), text.end(), isSymmetric ? 2 : 1,
+            [numVertices, isPattern, isReal, isSymmetric, mirrorSign](const char* line, const char* end, Edge* edge)
+        {
+            long long values[2];
+            const char* cursor = line;
+            if (!parseFields(cursor, end, values, 2, true))
+            {
+                throw invalid_argument("Invalid Matrix Market file: Malformed entry \"" + string(line, end) + "\"");
+            }
+            edge->source = toVertex(values[0], 1);
+            edge->target = toVertex(values[1], 1);
+            if (edge->source >= numVertices || edge->target >= numVertices)
+            {
+                throw invalid_argument("Invalid Matrix Market file: Entry out of range in \"" + string(line, end) + "\"");
+            }
+            if (isPattern)
+            {
+                edge->weight = 1;
+            }
+            else
+            {
+                edge->weight = isReal ? parseIntegralReal(cursor, end) : parseWeight(cursor, end);
+            }
+            if (isSymmetric && edge->source != edge->target)
+            {
+                edge[1].source = edge->target;
+                edge[1].target = edge->source;
+                edge[1].weight = mirrorSign * edge->weight;
+            }
+        }, &numEntries);
+
+        // A truncated or concatenated file has a different number of entries than its size line declares
+        if (numEntries != static_cast<size_t>(size[2]))
+        {
+            throw invalid_argument("Invalid Matrix Market file: Expected " + to_string(size[2]) + " entries, found " +
+                                   to_string(numEntries));
+        }
+
+        // fromEdges() keeps one edge per (source, target), so a duplicate entry leaves fewer edges than were parsed
+        Graph graph = fromEdges(numVertices, edges);
+        size_t numParsedEdges = 0;
+        for (size_t i = 0; i < edges.size(); i++)
+        {
+            if (edges[i].weight != 0)
+            {
+                numParsedEdges++;
+            }
+        }
+        if (graph.getOutEdges().numEntries() != numParsedEdges)
+        {
+            throw invalid_argument("Invalid Matrix Market file: An entry appears more than once");
+        }
+        *this = graph;
+    }
+
+
+    /**
+     * @brief This method saves the graph to a Matrix Market (.mtx) coordinate file with integer weights.
+     *
+     * Only the edges are written. An undirected graph is written as a symmetric matrix (its lower triangle only).
+     * @param path The path of the file.
+     * @throws If the file cannot be written throw runtime_error exception
+     */
+    void Graph::saveMatrixMarketFile(const string& path) const
+    {
+        const AdjacencyIndex& edges = getOutEdges();
+        bool isSymmetric = !(*this)._isDirected;
+
+        // Count the entries that will be written (the lower triangle of a symmetric matrix)
+        size_t numEntries = 0;
+        for (size_t i = 0; i < (*this)._numVertices; i++)
+        {
+            for (size_t e = edges.offsets[i]; e < edges.offsets[i + 1]; e++)
+            {
+                if (!isSymmetric || edges.targets[e] <= i)
+                {
+                    numEntries++;
+                }
+            }
+        }
+
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            throw runtime_error("Cannot open " + path + " for writing: " + strerror(errno));
+        }
+
+        try
+        {
+            ImageWriter writer(fd);
+            string header = string("%%MatrixMarket matrix coordinate integer ") + (isSymmetric ? "symmetric" : "general") + "\n" +
+                to_string((*this)._numVertices) + " " + to_string((*this)._numVertices) + " " + to_string(numEntries) + "\n";
+            writer.write(header.data(), header.size());
+
+            // Stream the entries (1-based) through the writer's buffer
+            char entry[64];
+            for (size_t i = 0; i < (*this)._numVertices; i++)
+            {
+                for (size_t e = edges.offsets[i]; e < edges.offsets[i + 1]; e++)
+                {
+                    if (!isSymmetric || edges.targets[e] <= i)
+                    {
+                        size_t length = formatInteger(entry, static_cast<long long>(i) + 1);
+                        entry[length++] = ' ';
+                        length += formatInteger(entry + length, static_cast<long long>(edges.targets[e]) + 1);
+                        entry[length++] = ' ';
+                        length += formatInteger(entry + length, edges.weights[e]);
+                        entry[length++] = '\n';
+                        writer.write(entry, length);
+                    }
+                }
+            }
+            writer.flush();
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+
+        if (::close(fd) != 0)
+        {
+            throw runtime_error("Cannot save graph to " + path + ": " + strerror(errno));
+        }
+    }
+
+
+    /*********************************************/
+    ///             PRIVATE SECTION             ///
+    /*********************************************/
+
+    /**
+     * @brief This auxiliary function writes the graph in the binary graph format to a file descriptor.
+     *
+     * @param fd The file descriptor to write to.
+     * @param withIndexes true to always write the CSR layout, followed by the reversed edges of a directed graph, so that
+     * a graph mapping the image never builds an index of its own; false to write the smaller layout only.
+     * @throws If writing fails throw runtime_error exception
+     */
+    void Graph::writeImage(int fd, bool withIndexes) const
+    {
+        size_t numVertices = (*this)._numVertices;
+        const AdjacencyIndex& edges = getOutEdges();
+        size_t numEntries = edges.numEntries();
+
+        // Choose the smaller of the two layouts (sparse graphs are never expanded to a matrix)
+        size_t denseBytes = numVertices * numVertices * sizeof(int);
+        size_t csrBytes = (numVertices + 1) * sizeof(uint64_t) + numEntries * (sizeof(uint32_t) + sizeof(int));
+        bool useCsr = withIndexes || (*this)._storage == Storage::Sparse || csrBytes < denseBytes;
+        bool withReverse = withIndexes && (*this)._isDirected;
+
+        // The magic number is written last, so a reader never accepts a partially written image
+        ImageHeader header;
+        memset(&header, 0, sizeof(header));
+        header.version = IMAGE_VERSION;
+        header.layout = useCsr ? LAYOUT_CSR : LAYOUT_DENSE;
+        header.weightType = WEIGHT_INT32;
+        header.flags = ((*this)._isDirected ? FLAG_DIRECTED : 0) | (withReverse ? FLAG_REVERSE_CSR : 0);
+        header.numVertices = numVertices;
+        header.numEdges = (*this)._numEdges;
+        header.numEntries = useCsr ? numEntries : 0;
+
+        ImageWriter writer(fd);
+        writer.write(&header, sizeof(header));
+        if (useCsr)
+        {
+            writer.write(edges.offsets, (numVertices + 1) * sizeof(uint64_t));
+            writer.write(edges.targets, numEntries * sizeof(uint32_t));
+            writer.write(edges.weights, numEntries * sizeof(int));
+        }
+        else
+        {
+            for (size_t i = 0; i < numVertices; i++)
+            {
+                writer.write(denseRow(i), numVertices * sizeof(int));
+            }
+        }
+        if (withReverse)
+        {
+            // The reversed edges have the same number of entries; the sections are 8-byte multiples, so this one stays aligned
+            const AdjacencyIndex& inEdges = getInEdges();
+            writer.write(inEdges.offsets, (numVertices + 1) * sizeof(uint64_t));
+            writer.write(inEdges.targets, numEntries * sizeof(uint32_t));
+            writer.write(inEdges.weights, numEntries * sizeof(int));
+        }
+        writer.flush();
+
+        if (pwrite(fd, IMAGE_MAGIC, sizeof(IMAGE_MAGIC), 0) != static_cast<ssize_t>(sizeof(IMAGE_MAGIC)))
+        {
+            throw runtime_error(string("Cannot write graph image: ") + strerror(errno));
+        }
+    }
+
+
+    /**
+     * @brief This auxiliary function maps a binary graph image read-only and creates a graph on top of it.
+     *
+     * @param fd A descriptor of the file or shared memory segment that holds the image (closed by this function).
+     * @param source The name of the file or segment, for error messages.
+     * @return A graph that reads its edges directly from the mapping.
+     * @throws If the image cannot be mapped throw runtime_error exception, if it is malformed throw invalid_argument exception
+     */
+    Graph Graph::mapImage(int fd, const string& source)
+    {
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw runtime_error("Cannot stat " + source + ": " + strerror(errno));
+        }
+
+        size_t length = static_cast<size_t>(info.st_size);
+        if (length < sizeof(ImageHeader))
+        {
+            ::close(fd);
+            throw invalid_argument("Invalid graph file: " + source + " is too short");
+        }
+
+        void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);                    // The mapping stays valid after the descriptor is closed
+        if (address == MAP_FAILED)
+        {
+            throw runtime_error("Cannot map " + source + ": " + strerror(errno));
+        }
+
+        // The mapping is released when the last graph (or copy of it) that uses it is destroyed
+        shared_ptr<const void> mapping(address, [length](const void* mapped) { munmap(const_cast<void*>(mapped), length); });
+        return fromImage(static_cast<const char*>(address), length, mapping);
+    }
+
+
+    /**
+     * @brief This auxiliary function creates a graph on top of a binary graph image without copying it.
+     *
+     * @param image A pointer to the beginning of the image.
+     * @param length The size of the image in bytes.
+     * @param backing The owner of the image memory, kept alive by the returned graph.
+     * @return A graph that reads its edges directly from the image.
+     * @throws If the image is malformed throw invalid_argument exception
+     */
+    Graph Graph::fromImage(const char* image, size_t length, const shared_ptr<const void>& backing)
+    {
+        ImageHeader header;
+        memcpy(&header, image, sizeof(header));
+
+        if (memcmp(header.magic, IMAGE_MAGIC, sizeof(header.magic)) != 0)
+        {
+            throw invalid_argument("Invalid graph file: Bad magic number");
+        }
+        if (header.version != IMAGE_VERSION)
+        {
+            throw invalid_argument("Invalid graph file: Unsupported version " + to_string(header.version));
+        }
+        if (header.weightType != WEIGHT_INT32)
+        {
+            throw invalid_argument("Invalid graph file: Unsupported weight type " + to_string(header.weightType));
+        }
+        if (header.numVertices == 0)
+        {
+            throw invalid_argument("Invalid graph: The graph matrix is empty");
+        }
+        if (header.numVertices > UINT32_MAX)
+        {
+            throw invalid_argument("Invalid graph file: Too many vertices");
+        }
+
+        size_t numVertices = header.numVertices;
+        size_t payloadLength = length - sizeof(ImageHeader);
+        const char* payload = image + sizeof(ImageHeader);
+
+        Graph graph;
+        graph._numVertices = numVertices;
+        graph._numEdges = header.numEdges;
+        graph._isDirected = (header.flags & FLAG_DIRECTED) != 0;
+        graph._backing = backing;
+
+        if (header.layout == LAYOUT_DENSE)
+        {
+            if (numVertices > payloadLength / numVertices / sizeof(int))
+            {
+                throw invalid_argument("Invalid graph file: Truncated adjacency matrix");
+            }
+            graph._storage = Storage::ExternalDense;
+            graph._denseData = reinterpret_cast<const int*>(payload);
+            graph._denseStride = numVertices;
+            return graph;
+        }
+
+        if (header.layout != LAYOUT_CSR)
+        {
+            throw invalid_argument("Invalid graph file: Unknown layout " + to_string(header.layout));
+        }
+
+        graph._storage = Storage::Sparse;
+        graph._outEdges.reset(mapCsrSection(payload, payloadLength, numVertices, header.numEntries, backing));
+        if (header.flags & FLAG_REVERSE_CSR)
+        {
+            size_t sectionLength = (numVertices + 1) * sizeof(uint64_t) + header.numEntries * (sizeof(uint32_t) + sizeof(int));
+            graph._inEdges.reset(mapCsrSection(payload + sectionLength, payloadLength - sectionLength, numVertices, header.numEntries, backing));
+        }
+        return graph;
+    }
+}
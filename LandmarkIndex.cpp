@@ -0,0 +1,172 @@
+// Email: origoldbsc@gmail.com
+
+#include "LandmarkIndex.hpp"
+#include "Parallel.hpp"
+#include <stdexcept>
+#include <climits>
+#include <queue>
+#include <functional>
+
+namespace ariel {
+
+    const size_t LandmarkIndex::DEFAULT_NUM_LANDMARKS;
+
+    namespace {
+
+        /**
+         * @brief This auxiliary function computes the distances from a vertex to all the vertices with Dijkstra's algorithm.
+         *
+         * @param edges The edges to follow (the reversed index gives the distances to the vertex instead).
+         * @param source The vertex to start from.
+         * @param distance Set to the distance of every vertex (LLONG_MAX for unreachable vertices).
+         */
+        void singleSourceDistances(const AdjacencyIndex& edges, size_t source, vector<long long>& distance)
+        {
+            typedef pair<long long, size_t> Entry;
+            priority_queue<Entry, vector<Entry>, greater<Entry>> heap;
+            distance.assign(edges.numVertices, LLONG_MAX);
+            distance[source] = 0;
+            heap.push(make_pair(0LL, source));
+
+            while (!heap.empty())
+            {
+                Entry top = heap.top();
+                heap.pop();
+                size_t vertex_u = top.second;
+                if (top.first != distance[vertex_u])
+                {
+                    continue;       // A stale entry
+                }
+                for (size_t e = edges.offsets[vertex_u]; e < edges.offsets[vertex_u + 1]; e++)
+                {
+                    size_t vertex_v = edges.targets[e];
+                    long long candidate = top.first + edges.weights[e];
+                    if (candidate < distance[vertex_v])
+                    {
+                        distance[vertex_v] = candidate;
+                        heap.push(make_pair(candidate, vertex_v));
+                    }
+                }
+            }
+        }
+    }
+
+
+    /**
+     * @brief This method builds the index of a graph.
+     *
+     * The landmarks are chosen greedily: each one is the vertex farthest from the landmarks chosen so far (a vertex that
+     * none of them reaches is the farthest). Building runs two full Dijkstra searches per landmark; the backward searches
+     * run in parallel.
+     *
+     * @param graph The graph.
+     * @param numLandmarks The number of landmarks (at most the number of vertices).
+     * @return The index.
+     * @throws If the graph has negative weights throw invalid_argument exception
+     */
+    LandmarkIndex LandmarkIndex::build(const Graph& graph, size_t numLandmarks)
+    {
+        if (graph.getMinWeight() < 0)
+        {
+            throw invalid_argument("Invalid graph: Landmarks require non-negative weights");
+        }
+
+        const AdjacencyIndex& outEdges = graph.getOutEdges();
+        const AdjacencyIndex& inEdges = graph.getInEdges();        // Built before the backward searches share it
+        size_t numVertices = graph.getNumVertices();
+        numLandmarks = min(numLandmarks, numVertices);
+
+        LandmarkIndex index;
+        index._numVertices = numVertices;
+        index._fromLandmark.assign(numVertices * numLandmarks, LLONG_MAX);
+        index._toLandmark.assign(numVertices * numLandmarks, LLONG_MAX);
+
+        // Choose the landmarks one by one, each as far as possible from the previous ones (the first one is far from vertex 0)
+        vector<long long> nearest(numVertices, LLONG_MAX);     // The distance from the closest landmark chosen so far
+        vector<long long> distance;
+        singleSourceDistances(outEdges, 0, nearest);
+        nearest[0] = -1;
+        for (size_t i = 0; i < numLandmarks; i++)
+        {
+            size_t landmark = 0;
+            for (size_t v = 1; v < numVertices; v++)
+            {
+                if (nearest[v] > nearest[landmark])
+                {
+                    landmark = v;
+                }
+            }
+            index._landmarks.push_back(landmark);
+
+            singleSourceDistances(outEdges, landmark, distance);
+            for (size_t v = 0; v < numVertices; v++)
+            {
+                index._fromLandmark[v * numLandmarks + i] = distance[v];
+                nearest[v] = i == 0 ? distance[v] : min(nearest[v], distance[v]);
+            }
+            for (size_t j = 0; j <= i; j++)
+            {
+                nearest[index._landmarks[j]] = -1;     // Never choose a landmark twice
+            }
+        }
+
+        // The distances to the landmarks are independent searches over the reversed edges
+        Parallel::forRange(numLandmarks, 1, [&index, &inEdges, numLandmarks, numVertices](size_t begin, size_t end)
+        {
+            vector<long long> toDistance;
+            for (size_t i = begin; i < end; i++)
+            {
+                singleSourceDistances(inEdges, index._landmarks[i], toDistance);
+                for (size_t v = 0; v < numVertices; v++)
+                {
+                    index._toLandmark[v * numLandmarks + i] = toDistance[v];
+                }
+            }
+        });
+
+        return index;
+    }
+
+
+    /**
+     * @brief This method returns the landmark vertices.
+     * @return The landmarks, in the order they were chosen.
+     */
+    const vector<size_t>& LandmarkIndex::getLandmarks() const
+    {
+        return (*this)._landmarks;
+    }
+
+
+    /**
+     * @brief This method returns a lower bound on the distance between two vertices.
+     *
+     * @param vertex The source vertex.
+     * @param target The target vertex.
+     * @return A lower bound on d(vertex, target) (0 if no landmark gives a better one).
+     */
+    long long LandmarkIndex::lowerBound(size_t vertex, size_t target) const
+    {
+        size_t numLandmarks = (*this)._landmarks.size();
+        const long long* fromVertex = &(*this)._fromLandmark[vertex * numLandmarks];
+        const long long* fromTarget = &(*this)._fromLandmark[target * numLandmarks];
+        const long long* toVertex = &(*this)._toLandmark[vertex * numLandmarks];
+        const long long* toTarget = &(*this)._toLandmark[target * numLandmarks];
+        long long bound = 0;
+
+        for (size_t i = 0; i < numLandmarks; i++)
+        {
+            // d(L,t) <= d(L,v) + d(v,t)
+            if (fromTarget[i] != LLONG_MAX && fromVertex[i] != LLONG_MAX)
+            {
+                bound = max(bound, fromTarget[i] - fromVertex[i]);
+            }
+            // d(v,L) <= d(v,t) + d(t,L)
+            if (toVertex[i] != LLONG_MAX && toTarget[i] != LLONG_MAX)
+            {
+                bound = max(bound, toVertex[i] - toTarget[i]);
+            }
+        }
+        return bound;
+    }
+}
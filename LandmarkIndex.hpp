@@ -0,0 +1,67 @@
+// Email: origoldbsc@gmail.com
+
+#ifndef LANDMARKINDEX_HPP
+#define LANDMARKINDEX_HPP
+
+#include "Graph.hpp"
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+namespace ariel {
+
+/**
+* @brief This class represents an ALT (A*, landmarks, triangle inequality) index of a graph with non-negative weights.
+*
+* It stores the distances from and to a few landmark vertices. By the triangle inequality, d(L,t) - d(L,v) and d(v,L) - d(t,L)
+* are lower bounds on d(v,t) for every landmark L, and their maximum is a consistent A* heuristic.
+*/
+class LandmarkIndex {
+
+    private:
+        size_t _numVertices;                    // The number of vertices of the indexed graph
+        vector<size_t> _landmarks;              // The landmark vertices
+        vector<long long> _fromLandmark;        // d(L_i, v) at v * numLandmarks + i (LLONG_MAX if v is unreachable from L_i)
+        vector<long long> _toLandmark;          // d(v, L_i) at v * numLandmarks + i (LLONG_MAX if L_i is unreachable from v)
+
+    public:
+
+        static const size_t DEFAULT_NUM_LANDMARKS = 8;      // The number of landmarks of the index cached by a Graph
+
+
+        /**
+         * @brief This method builds the index of a graph.
+         *
+         * The landmarks are chosen greedily: each one is the vertex farthest from the landmarks chosen so far (a vertex that
+         * none of them reaches is the farthest). Building runs two full Dijkstra searches per landmark; the backward searches
+         * run in parallel.
+         *
+         * @param graph The graph.
+         * @param numLandmarks The number of landmarks (at most the number of vertices).
+         * @return The index.
+         * @throws If the graph has negative weights throw invalid_argument exception
+         */
+        static LandmarkIndex build(const Graph& graph, size_t numLandmarks);
+
+
+        /**
+         * @brief This method returns the landmark vertices.
+         * @return The landmarks, in the order they were chosen.
+         */
+        const vector<size_t>& getLandmarks() const;
+
+
+        /**
+         * @brief This method returns a lower bound on the distance between two vertices.
+         *
+         * @param vertex The source vertex.
+         * @param target The target vertex.
+         * @return A lower bound on d(vertex, target) (0 if no landmark gives a better one).
+         */
+        long long lowerBound(size_t vertex, size_t target) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,247 @@
+// Email: origoldbsc@gmail.com
+
+#include "Parallel.hpp"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+
+namespace ariel {
+
+    namespace {
+        atomic<size_t> configuredThreads(0);      // The number of threads set by setNumThreads (0 = hardware default)
+
+
+        /**
+         * @brief This auxiliary class keeps the worker threads alive between calls to Parallel::run.
+         *
+         * Starting a thread costs tens of microseconds, which is more than a level of a BFS or a bucket of a delta-stepping
+         * search takes, so the threads are started once (the pool grows to the largest number of workers asked for) and wait
+         * for tasks. A thread that waits for its own tasks runs queued tasks meanwhile, so nested calls cannot deadlock.
+         */
+        class ThreadPool {
+
+            private:
+                struct Task {
+                    const function<void()>* body;       // The work (owned by the caller of runAll)
+                    size_t* remaining;                  // The number of unfinished tasks of the same call
+                };
+
+                mutex _mutex;
+                condition_variable _hasTasks;           // Signalled when a task is queued or the pool stops
+                condition_variable _taskDone;           // Signalled when the last task of a call finishes
+                deque<Task> _tasks;
+                vector<thread> _threads;
+                bool _stopping;
+
+
+                /**
+                 * @brief This auxiliary function runs a task without holding the lock and marks it as done.
+                 */
+                void execute(const Task& task, unique_lock<mutex>& lock)
+                {
+                    lock.unlock();
+                    (*task.body)();                     // The bodies catch their own exceptions
+                    lock.lock();
+                    if (--(*task.remaining) == 0)
+                    {
+                        _taskDone.notify_all();
+                    }
+                }
+
+
+                /**
+                 * @brief This auxiliary function is the loop of every pool thread.
+                 */
+                void work()
+                {
+                    unique_lock<mutex> lock(_mutex);
+                    while (true)
+                    {
+                        _hasTasks.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                        if (_tasks.empty())
+                        {
+                            return;
+                        }
+                        Task task = _tasks.front();
+                        _tasks.pop_front();
+                        execute(task, lock);
+                    }
+                }
+
+            public:
+                ThreadPool() : _stopping(false)
+                {
+                }
+
+
+                ~ThreadPool()
+                {
+                    {
+                        lock_guard<mutex> lock(_mutex);
+                        _stopping = true;
+                    }
+                    _hasTasks.notify_all();
+                    for (size_t i = 0; i < _threads.size(); i++)
+                    {
+                        _threads[i].join();
+                    }
+                }
+
+
+                /**
+                 * @brief This auxiliary function runs the first body on the calling thread and the others on the pool, and
+                 * waits until all of them are done.
+                 */
+                void runAll(const vector<function<void()>>& bodies)
+                {
+                    size_t remaining = bodies.size() - 1;
+                    {
+                        lock_guard<mutex> lock(_mutex);
+                        while (_threads.size() < remaining)
+                        {
+                            _threads.emplace_back(&ThreadPool::work, this);
+                        }
+                        for (size_t i = 1; i < bodies.size(); i++)
+                        {
+                            _tasks.push_back(Task{&bodies[i], &remaining});
+                        }
+                    }
+                    _hasTasks.notify_all();
+
+                    bodies[0]();
+
+                    // Help with queued tasks (of this call or of others) until the tasks of this call are done
+                    unique_lock<mutex> lock(_mutex);
+                    while (remaining > 0)
+                    {
+                        if (!_tasks.empty())
+                        {
+                            Task task = _tasks.front();
+                            _tasks.pop_front();
+                            execute(task, lock);
+                        }
+                        else
+                        {
+                            _taskDone.wait(lock);
+                        }
+                    }
+                }
+        };
+
+
+        /**
+         * @brief This auxiliary function returns the pool shared by all the parallel parts of the library.
+         */
+        ThreadPool& sharedPool()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+    }
+
+
+    /**
+     * @brief This method returns the number of threads parallel work is split into.
+     *
+     * @return The configured number of threads, or the number of hardware threads if none was configured.
+     */
+    size_t Parallel::getNumThreads()
+    {
+        size_t numThreads = configuredThreads.load();
+        if (numThreads == 0)
+        {
+            numThreads = max(1u, thread::hardware_concurrency());
+        }
+        return numThreads;
+    }
+
+
+    /**
+     * @brief This method sets the number of threads parallel work is split into.
+     *
+     * @param numThreads The number of threads, or 0 to use the number of hardware threads.
+     */
+    void Parallel::setNumThreads(size_t numThreads)
+    {
+        configuredThreads.store(numThreads);
+    }
+
+
+    /**
+     * @brief This method runs a function once for every worker index, each on its own thread, and waits for all of them.
+     *
+     * Worker 0 runs on the calling thread, the others on a pool of threads that is shared by all calls and kept alive between
+     * them.
+     * @param numWorkers The number of workers.
+     * @param worker The function to run, called with the index of the worker.
+     * @throws The first exception thrown by a worker, after all workers have finished.
+     */
+    void Parallel::run(size_t numWorkers, const function<void(size_t)>& worker)
+    {
+        vector<exception_ptr> errors(numWorkers);
+        vector<function<void()>> bodies;
+        bodies.reserve(numWorkers);
+
+        for (size_t i = 0; i < numWorkers; i++)
+        {
+            bodies.push_back([&worker, &errors, i]()
+            {
+                try
+                {
+                    worker(i);
+                }
+                catch (...)
+                {
+                    errors[i] = current_exception();
+                }
+            });
+        }
+
+        if (numWorkers == 1)
+        {
+            bodies[0]();
+        }
+        else if (numWorkers > 1)
+        {
+            sharedPool().runAll(bodies);
+        }
+
+        // Rethrow the first failure (if any) on the calling thread
+        for (size_t i = 0; i < numWorkers; i++)
+        {
+            if (errors[i])
+            {
+                rethrow_exception(errors[i]);
+            }
+        }
+    }
+
+
+    /**
+     * @brief This method splits the range [0, count) into contiguous chunks and processes them in parallel.
+     *
+     * Ranges smaller than two grains are processed on the calling thread.
+     * @param count The size of the range.
+     * @param grainSize The minimal number of elements worth handing to a thread.
+     * @param body The function to run, called with the bounds [begin, end) of each chunk.
+     */
+    void Parallel::forRange(size_t count, size_t grainSize, const function<void(size_t, size_t)>& body)
+    {
+        size_t numChunks = min(getNumThreads(), count / max<size_t>(grainSize, 1));
+        if (numChunks <= 1)
+        {
+            body(0, count);
+            return;
+        }
+
+        run(numChunks, [count, numChunks, &body](size_t chunk)
+        {
+            body(count * chunk / numChunks, count * (chunk + 1) / numChunks);
+        });
+    }
+}
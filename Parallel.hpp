@@ -0,0 +1,59 @@
+// Email: origoldbsc@gmail.com
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+using namespace std;
+
+namespace ariel {
+
+/**
+* @brief This class runs work on several threads for the parallel parts of the library (loaders and algorithms).
+*/
+class Parallel {
+
+    public:
+
+        /**
+         * @brief This method returns the number of threads parallel work is split into.
+         * @return The configured number of threads, or the number of hardware threads if none was configured.
+         */
+        static size_t getNumThreads();
+
+
+        /**
+         * @brief This method sets the number of threads parallel work is split into.
+         * @param numThreads The number of threads, or 0 to use the number of hardware threads.
+         */
+        static void setNumThreads(size_t numThreads);
+
+
+        /**
+         * @brief This method runs a function once for every worker index, each on its own thread, and waits for all of them.
+         *
+         * Worker 0 runs on the calling thread, the others on a pool of threads that is shared by all calls and kept alive
+         * between them.
+         * @param numWorkers The number of workers.
+         * @param worker The function to run, called with the index of the worker.
+         * @throws The first exception thrown by a worker, after all workers have finished.
+         */
+        static void run(size_t numWorkers, const function<void(size_t)>& worker);
+
+
+        /**
+         * @brief This method splits the range [0, count) into contiguous chunks and processes them in parallel.
+         *
+         * Ranges smaller than two grains are processed on the calling thread.
+         * @param count The size of the range.
+         * @param grainSize The minimal number of elements worth handing to a thread.
+         * @param body The function to run, called with the bounds [begin, end) of each chunk.
+         */
+        static void forRange(size_t count, size_t grainSize, const function<void(size_t, size_t)>& body);
+};
+
+}
+
+#endif
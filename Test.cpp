@@ -3,7 +3,16 @@
 #include "doctest.h"
 #include "Algorithms.hpp"
 #include "Graph.hpp"
+#include "Parallel.hpp"
+#include "DisjointSet.hpp"
+#include "LandmarkIndex.hpp"
+#include "ContractionHierarchy.hpp"
 #include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
 
 using namespace ariel;
 using namespace std;
@@ -976,4 +985,1569 @@ TEST_CASE("operator<<: Verify output stream")
     ostringstream oss;
     oss<<g1;
     CHECK(oss.str() == "[0, 1, 2]\n[1, 0, 3]\n[2, 3, 0]");
-}
\ No newline at end of file
+}
+
+// Test Case for save and open
+TEST_CASE("save/open: Round trip of a dense graph") 
+{
+    vector<vector<int>> graph1 = {
+        {0, 1, 2},
+        {1, 0, 3},
+        {2, 3, 0}};
+    g1.loadGraph(graph1);
+    g1.save("test_graph.bin");
+
+    Graph opened = Graph::open("test_graph.bin");
+    CHECK(opened.printGraph() == "[0, 1, 2]\n[1, 0, 3]\n[2, 3, 0]");
+    CHECK(opened.getNumVertices() == 3);
+    CHECK(opened.getNumEdges() == 3);
+    CHECK(opened.isGraphDirected() == false);
+    CHECK(Algorithms::shortestPath(opened, 0, 2) == "0->2");
+
+    // Modifying the opened graph must not touch the file
+    opened *= 2;
+    CHECK(opened.printGraph() == "[0, 2, 4]\n[2, 0, 6]\n[4, 6, 0]");
+    CHECK(Graph::open("test_graph.bin").printGraph() == "[0, 1, 2]\n[1, 0, 3]\n[2, 3, 0]");
+    remove("test_graph.bin");
+}
+
+TEST_CASE("save/open: Round trip of a sparse directed graph") 
+{
+    vector<vector<int>> graph1(8, vector<int>(8, 0));
+    graph1[0][5] = 4;
+    graph1[5][7] = -2;
+    graph1[7][1] = 9;
+    g1.loadGraph(graph1);
+    g1.save("test_graph.bin");
+
+    Graph opened = Graph::open("test_graph.bin");
+    CHECK(opened.getNumEdges() == 3);
+    CHECK(opened.isGraphDirected() == true);
+    CHECK(opened.getEdgeWeight(5, 7) == -2);
+    CHECK(opened.getEdgeWeight(7, 5) == 0);
+    CHECK(opened.getOutEdges().degree(0) == 1);
+    CHECK(opened == g1);
+    CHECK(Algorithms::shortestPath(opened, 0, 1) == "0->5->7->1");
+    CHECK(opened.getAdjacencyMatrix() == graph1);
+    remove("test_graph.bin");
+}
+
+TEST_CASE("save/open and publish/attach: Round trip of graphs built from edges") 
+{
+    auto fileSize = [](const string& path)
+    {
+        ifstream file(path, ios::binary | ios::ate);
+        return static_cast<size_t>(file.tellg());
+    };
+
+    // A CSR image holds a 64-byte header, then offsets[V+1] (8 bytes each) and 8 bytes per entry, once per stored index
+    vector<Edge> edges = {{0, 5, 4}, {5, 7, -2}, {7, 1, 9}, {1, 0, 3}};
+    Graph directed = Graph::fromEdges(8, edges);
+    vector<Edge> mirrored = edges;
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        mirrored.push_back(Edge{edges[i].target, edges[i].source, edges[i].weight});
+    }
+    Graph undirected = Graph::fromEdges(8, mirrored);
+    CHECK(directed.isGraphDirected() == true);
+    CHECK(undirected.isGraphDirected() == false);
+
+    Graph* graphs[] = {&directed, &undirected};
+    for (Graph* graph : graphs)
+    {
+        size_t numEntries = graph->getOutEdges().numEntries();
+        size_t csrSize = 9 * 8 + numEntries * 8;
+
+        graph->save("test_graph.bin");
+        CHECK(fileSize("test_graph.bin") == 64 + csrSize);
+        Graph opened = Graph::open("test_graph.bin");
+        CHECK(opened == *graph);
+        CHECK(opened.getNumEdges() == graph->getNumEdges());
+        CHECK(opened.isGraphDirected() == graph->isGraphDirected());
+        CHECK(Algorithms::shortestPath(opened, 0, 1) == Algorithms::shortestPath(*graph, 0, 1));
+
+        // A graph opened from a CSR image is stored sparsely, and can be saved again (to another file, since it maps this one)
+        opened.save("test_graph_copy.bin");
+        CHECK(fileSize("test_graph_copy.bin") == 64 + csrSize);
+        CHECK(Graph::open("test_graph_copy.bin") == *graph);
+
+        // Only a directed graph is published with its reversed edges
+        graph->publish("ariel_test_graph");
+        CHECK(fileSize("/dev/shm/ariel_test_graph") == 64 + csrSize * (graph->isGraphDirected() ? 2 : 1));
+        Graph attached = Graph::attach("ariel_test_graph");
+        CHECK(attached == *graph);
+        CHECK(attached.getInEdges().findWeight(5, 0) == 4);
+        CHECK(Algorithms::shortestPath(attached, 0, 1) == Algorithms::shortestPath(*graph, 0, 1));
+        Graph::unpublish("ariel_test_graph");
+    }
+
+    // A dense path is written as CSR, a small complete graph as a matrix (whichever is smaller)
+    vector<vector<int>> path(100, vector<int>(100, 0));
+    for (size_t i = 0; i + 1 < 100; i++)
+    {
+        path[i][i + 1] = 1;
+        path[i + 1][i] = 1;
+    }
+    g1.loadGraph(path);
+    g1.save("test_graph.bin");
+    CHECK(fileSize("test_graph.bin") == 64 + 101 * 8 + 198 * 8);
+    CHECK(Graph::open("test_graph.bin") == g1);
+
+    vector<vector<int>> complete = {
+        {0, 1, 2},
+        {1, 0, 3},
+        {2, 3, 0}};
+    g1.loadGraph(complete);
+    g1.save("test_graph.bin");
+    CHECK(fileSize("test_graph.bin") == 64 + 9 * 4);
+    CHECK(Graph::open("test_graph.bin") == g1);
+    remove("test_graph.bin");
+    remove("test_graph_copy.bin");
+}
+
+TEST_CASE("open: Reject missing and malformed files") 
+{
+    CHECK_THROWS_AS(Graph::open("missing_graph.bin"), runtime_error);
+
+    FILE* file = fopen("test_graph.bin", "wb");
+    string garbage(100, 'x');
+    fwrite(garbage.data(), 1, garbage.size(), file);
+    fclose(file);
+    CHECK_THROWS_AS(Graph::open("test_graph.bin"), invalid_argument);
+
+    // A corrupt sparse image is rejected when it is opened, not read out of bounds later
+    vector<vector<int>> graph1(8, vector<int>(8, 0));
+    graph1[0][5] = 4;
+    graph1[5][7] = -2;
+    graph1[7][1] = 9;
+    g1.loadGraph(graph1);
+    auto corrupt = [](long position, uint64_t value, size_t size)
+    {
+        g1.save("test_graph.bin");
+        FILE* image = fopen("test_graph.bin", "r+b");
+        fseek(image, position, SEEK_SET);
+        fwrite(&value, size, 1, image);
+        fclose(image);
+    };
+    corrupt(24, uint64_t(1) << 40, sizeof(uint64_t));       // The number of vertices
+    CHECK_THROWS_AS(Graph::open("test_graph.bin"), invalid_argument);
+    corrupt(64 + 8, 3, sizeof(uint64_t));                    // offsets[1] > offsets[2]
+    CHECK_THROWS_AS(Graph::open("test_graph.bin"), invalid_argument);
+    corrupt(64 + 9 * 8, 100, sizeof(uint32_t));              // targets[0]
+    CHECK_THROWS_AS(Graph::open("test_graph.bin"), invalid_argument);
+    corrupt(64 + 9 * 8, 5, sizeof(uint32_t));
+    CHECK(Graph::open("test_graph.bin") == g1);
+    remove("test_graph.bin");
+}
+
+
+// Test Case for loadMatrixFile
+TEST_CASE("loadMatrixFile: Load the output of printGraph") 
+{
+    ofstream file("test_graph.txt");
+    file << "[0, 1, 2]\n[1, 0, -3]\n\n[2, -3, 0]\n";
+    file.close();
+
+    g1.loadMatrixFile("test_graph.txt");
+    CHECK(g1.printGraph() == "[0, 1, 2]\n[1, 0, -3]\n[2, -3, 0]");
+    CHECK(g1.getNumEdges() == 3);
+    CHECK(g1.isGraphDirected() == false);
+    remove("test_graph.txt");
+}
+
+TEST_CASE("loadMatrixFile: Reject empty, non-square and malformed matrices") 
+{
+    ofstream("test_graph.txt") << "\n\n";
+    CHECK_THROWS_AS(g1.loadMatrixFile("test_graph.txt"), invalid_argument);
+
+    ofstream("test_graph.txt") << "0 1 2\n1 0 3\n";
+    CHECK_THROWS_AS(g1.loadMatrixFile("test_graph.txt"), invalid_argument);
+
+    ofstream("test_graph.txt") << "0 1\n1 0 3\n";
+    CHECK_THROWS_AS(g1.loadMatrixFile("test_graph.txt"), invalid_argument);
+
+    ofstream("test_graph.txt") << "0 1\n1 x\n";
+    CHECK_THROWS_AS(g1.loadMatrixFile("test_graph.txt"), invalid_argument);
+
+    CHECK_THROWS_AS(g1.loadMatrixFile("missing_graph.txt"), runtime_error);
+    remove("test_graph.txt");
+}
+
+TEST_CASE("loadMatrixFile: Parse a large matrix on several threads") 
+{
+    const size_t numVertices = 1200;
+    ofstream file("test_graph.txt");
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        for (size_t j = 0; j < numVertices; j++)
+        {
+            file << (j == (i + 1) % numVertices ? 7 : 0) << (j + 1 < numVertices ? " " : "\n");
+        }
+    }
+    file.close();
+
+    Parallel::setNumThreads(4);
+    g1.loadMatrixFile("test_graph.txt");
+    Parallel::setNumThreads(0);
+
+    CHECK(g1.getNumVertices() == numVertices);
+    CHECK(g1.getNumEdges() == numVertices);
+    CHECK(g1.isGraphDirected() == true);
+    CHECK(g1.getEdgeWeight(numVertices - 1, 0) == 7);
+    CHECK(Algorithms::isConnected(g1) == true);
+    remove("test_graph.txt");
+}
+
+// Test Case for loadEdgeListFile
+TEST_CASE("loadEdgeListFile: Load a weighted edge list") 
+{
+    ofstream file("test_graph.txt");
+    file << "# u v w\n0 1 4\n1 2 -2\n\n2 0 5\n1 2 3\n3 3 1";
+    file.close();
+
+    g1.loadEdgeListFile("test_graph.txt");
+    CHECK(g1.printGraph() == "[0, 4, 0, 0]\n[0, 0, 3, 0]\n[5, 0, 0, 0]\n[0, 0, 0, 1]");
+    CHECK(g1.getNumEdges() == 4);
+    CHECK(g1.isGraphDirected() == true);
+    CHECK(Algorithms::shortestPath(g1, 0, 2) == "0->1->2");
+
+    ofstream("test_graph.txt") << "0 1\n";
+    CHECK_THROWS_AS(g1.loadEdgeListFile("test_graph.txt"), invalid_argument);
+
+    ofstream("test_graph.txt") << "0 -1 2\n";
+    CHECK_THROWS_AS(g1.loadEdgeListFile("test_graph.txt"), invalid_argument);
+    remove("test_graph.txt");
+}
+
+// Test Case for fromEdges
+TEST_CASE("fromEdges: Build an undirected sparse graph") 
+{
+    vector<Edge> edges = {{0, 1, 2}, {1, 0, 2}, {2, 1, 0}, {1, 2, 5}, {2, 1, 5}};
+    Graph sparse = Graph::fromEdges(3, edges);
+    CHECK(sparse.isGraphDirected() == false);
+    CHECK(sparse.getNumEdges() == 2);
+    CHECK(sparse.printGraph() == "[0, 2, 0]\n[2, 0, 5]\n[0, 5, 0]");
+
+    vector<Edge> invalid = {{0, 3, 1}};
+    CHECK_THROWS_AS(Graph::fromEdges(3, invalid), invalid_argument);
+}
+
+// Test Case for loadMatrixMarketFile and saveMatrixMarketFile
+TEST_CASE("loadMatrixMarketFile: Load a symmetric pattern matrix as an undirected graph") 
+{
+    ofstream file("test_graph.mtx");
+    file << "%%MatrixMarket matrix coordinate pattern symmetric\n% a path 1-2-3\n3 3 2\n2 1\n3 2\n";
+    file.close();
+
+    g1.loadMatrixMarketFile("test_graph.mtx");
+    CHECK(g1.printGraph() == "[0, 1, 0]\n[1, 0, 1]\n[0, 1, 0]");
+    CHECK(g1.isGraphDirected() == false);
+    CHECK(g1.getNumEdges() == 2);
+    CHECK(Algorithms::isBipartite(g1) == "The graph is bipartite: A={0,2}, B={1}");
+    remove("test_graph.mtx");
+}
+
+TEST_CASE("loadMatrixMarketFile: Load general integer and real matrices") 
+{
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix coordinate integer general\n3 3 3\n1 2 4\n2 3 -1\n3 1 2\n";
+    g1.loadMatrixMarketFile("test_graph.mtx");
+    CHECK(g1.printGraph() == "[0, 4, 0]\n[0, 0, -1]\n[2, 0, 0]");
+    CHECK(g1.isGraphDirected() == true);
+
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 2 3.0e1\n";
+    g1.loadMatrixMarketFile("test_graph.mtx");
+    CHECK(g1.getEdgeWeight(0, 1) == 30);
+
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix coordinate real general\n2 2 1\n1 2 0.5\n";
+    CHECK_THROWS_AS(g1.loadMatrixMarketFile("test_graph.mtx"), invalid_argument);
+
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix coordinate integer general\n2 3 1\n1 2 1\n";
+    CHECK_THROWS_AS(g1.loadMatrixMarketFile("test_graph.mtx"), invalid_argument);
+
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix array integer general\n2 2\n1\n2\n3\n4\n";
+    CHECK_THROWS_AS(g1.loadMatrixMarketFile("test_graph.mtx"), invalid_argument);
+
+    // Missing, extra and repeated entries
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix coordinate integer general\n3 3 3\n1 2 4\n2 3 -1\n";
+    CHECK_THROWS_AS(g1.loadMatrixMarketFile("test_graph.mtx"), invalid_argument);
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix coordinate integer general\n3 3 1\n1 2 4\n2 3 -1\n";
+    CHECK_THROWS_AS(g1.loadMatrixMarketFile("test_graph.mtx"), invalid_argument);
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix coordinate integer general\n3 3 2\n1 2 4\n1 2 5\n";
+    CHECK_THROWS_AS(g1.loadMatrixMarketFile("test_graph.mtx"), invalid_argument);
+    ofstream("test_graph.mtx") << "%%MatrixMarket matrix coordinate pattern symmetric\n3 3 2\n2 1\n1 2\n";
+    CHECK_THROWS_AS(g1.loadMatrixMarketFile("test_graph.mtx"), invalid_argument);
+    remove("test_graph.mtx");
+}
+
+TEST_CASE("saveMatrixMarketFile: Round trip of directed and undirected graphs") 
+{
+    vector<vector<int>> graph1 = {
+        {0, 3, 0},
+        {3, 0, -2},
+        {0, -2, 5}};
+    g1.loadGraph(graph1);
+    g1.saveMatrixMarketFile("test_graph.mtx");
+
+    ifstream written("test_graph.mtx");
+    string contents((istreambuf_iterator<char>(written)), istreambuf_iterator<char>());
+    CHECK(contents == "%%MatrixMarket matrix coordinate integer symmetric\n3 3 3\n2 1 3\n3 2 -2\n3 3 5\n");
+
+    g2.loadMatrixMarketFile("test_graph.mtx");
+    CHECK(g2.printGraph() == g1.printGraph());
+    CHECK(g2.getNumEdges() == g1.getNumEdges());
+
+    vector<vector<int>> graph2 = {
+        {0, 1, 0},
+        {0, 0, 7},
+        {0, 0, 0}};
+    g1.loadGraph(graph2);
+    g1.saveMatrixMarketFile("test_graph.mtx");
+    g2.loadMatrixMarketFile("test_graph.mtx");
+    CHECK(g2.printGraph() == "[0, 1, 0]\n[0, 0, 7]\n[0, 0, 0]");
+    CHECK(g2.isGraphDirected() == true);
+    remove("test_graph.mtx");
+}
+
+// Test Case for GraphView
+TEST_CASE("GraphView: Run algorithms on a caller-owned buffer") 
+{
+    // A 4x4 directed cycle stored with a row stride of 5 (one padding element per row)
+    vector<int> buffer = {
+        0, 1, 0, 0, -9,
+        0, 0, 2, 0, -9,
+        0, 0, 0, 3, -9,
+        4, 0, 0, 0, -9};
+    GraphView view = {buffer.data(), 4, 5};
+
+    // The view is wrapped once, and every query reuses the same graph (and its CSR index)
+    Graph wrapped(view);
+    CHECK(Algorithms::isConnected(wrapped) == true);
+    CHECK(Algorithms::isStronglyConnected(wrapped) == true);
+    CHECK(Algorithms::shortestPath(wrapped, 1, 0) == "1->2->3->0");
+    CHECK(Algorithms::isContainsCycle(wrapped) == "0->1->2->3->0");
+    CHECK(Algorithms::negativeCycle(wrapped) == "No negative cycle exists");
+    CHECK(&wrapped.getOutEdges() == &wrapped.getOutEdges());
+
+    CHECK(wrapped.getNumEdges() == 4);
+    CHECK(wrapped.isGraphDirected() == true);
+
+    // Modifying the graph copies the matrix and never writes to the buffer
+    wrapped *= 2;
+    CHECK(wrapped.getEdgeWeight(0, 1) == 2);
+    CHECK(buffer[1] == 1);
+
+    GraphView invalid = {buffer.data(), 4, 3};
+    CHECK_THROWS_AS(Graph{invalid}, invalid_argument);
+}
+
+// Test Case for publish, attach and unpublish
+TEST_CASE("publish/attach: Share a graph through shared memory") 
+{
+    vector<vector<int>> graph1 = {
+        {0, 2, 0, 0},
+        {0, 0, 3, 0},
+        {0, 0, 0, -1},
+        {1, 0, 0, 0}};
+    g1.loadGraph(graph1);
+    g1.publish("ariel_test_graph");
+
+    Graph attached = Graph::attach("/ariel_test_graph");
+    CHECK(attached == g1);
+    CHECK(attached.getNumEdges() == 4);
+    CHECK(attached.isGraphDirected() == true);
+    CHECK(Algorithms::isStronglyConnected(attached) == true);
+    CHECK(Algorithms::shortestPath(attached, 0, 3) == "0->1->2->3");
+
+    // Even a dense graph is published with both of its CSR indexes, so the attached graph builds no private copy
+    CHECK(attached.getDenseRow(0) == nullptr);
+    CHECK(attached.getOutEdges().targetStorage.empty());
+    CHECK(attached.getInEdges().targetStorage.empty());
+    CHECK(attached.getInEdges().findWeight(3, 2) == -1);
+
+    // Attached graphs outlive the segment's name
+    Graph::unpublish("ariel_test_graph");
+    CHECK(attached.getEdgeWeight(2, 3) == -1);
+    CHECK_THROWS_AS(Graph::attach("ariel_test_graph"), runtime_error);
+    CHECK_THROWS_AS(Graph::unpublish("ariel_test_graph"), runtime_error);
+}
+
+// Test Case for stronglyConnectedComponents
+TEST_CASE("stronglyConnectedComponents: Components of a directed graph") 
+{
+    // {0,1,2} is a cycle that leads to {3,4}, which leads to the sink {5}
+    vector<vector<int>> graph1 = {
+        {0, 1, 0, 0, 0, 0},
+        {0, 0, 1, 0, 0, 0},
+        {1, 0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 1, 0},
+        {0, 0, 0, 1, 0, 1},
+        {0, 0, 0, 0, 0, 0}};
+    g1.loadGraph(graph1);
+
+    vector<size_t> component = Algorithms::stronglyConnectedComponents(g1);
+    CHECK(component == vector<size_t>({2, 2, 2, 1, 1, 0}));
+    CHECK(Algorithms::isStronglyConnected(g1) == false);
+}
+
+TEST_CASE("stronglyConnectedComponents: A long directed cycle") 
+{
+    const size_t numVertices = 50000;
+    vector<Edge> edges;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        edges.push_back(Edge{i, (i + 1) % numVertices, 1});
+    }
+    Graph cycle = Graph::fromEdges(numVertices, edges);
+    CHECK(Algorithms::isStronglyConnected(cycle) == true);
+
+    // Removing one edge splits the cycle into single-vertex components
+    edges.pop_back();
+    Graph path = Graph::fromEdges(numVertices, edges);
+    vector<size_t> component = Algorithms::stronglyConnectedComponents(path);
+    CHECK(Algorithms::isStronglyConnected(path) == false);
+    CHECK(component[0] == numVertices - 1);
+    CHECK(component[numVertices - 1] == 0);
+}
+
+// Test Case for condensation
+TEST_CASE("condensation: Component DAG of a directed graph") 
+{
+    // Components: {0,1,2} -> {3,4} -> {5}, with two edges between the first two components
+    vector<vector<int>> graph1 = {
+        {0, 1, 0, 0, 0, 0},
+        {0, 0, 1, 0, 7, 0},
+        {1, 0, 0, 5, 0, 0},
+        {0, 0, 0, 0, 1, 0},
+        {0, 0, 0, 1, 0, 4},
+        {0, 0, 0, 0, 0, 0}};
+    g1.loadGraph(graph1);
+
+    Graph dag = Algorithms::condensation(g1);
+    vector<vector<int>> expected = {
+        {0, 0, 0},
+        {4, 0, 0},
+        {0, 5, 0}};
+    CHECK(dag.getAdjacencyMatrix() == expected);
+    CHECK(Algorithms::isContainsCycle(dag) == "0");
+
+    // An undirected graph condenses to its connected components, with no edges between them
+    vector<vector<int>> graph2 = {
+        {0, 1, 0, 0},
+        {1, 0, 0, 0},
+        {0, 0, 0, 2},
+        {0, 0, 2, 0}};
+    g2.loadGraph(graph2);
+    Graph components = Algorithms::condensation(g2);
+    CHECK(components.getNumVertices() == 2);
+    CHECK(components.getNumEdges() == 0);
+
+    // A long path is already a DAG and condenses to a sparse copy of itself (in reverse order)
+    const size_t numVertices = 1000;
+    vector<Edge> edges;
+    for (size_t i = 0; i + 1 < numVertices; i++)
+    {
+        edges.push_back(Edge{i, i + 1, 3});
+    }
+    Graph path = Algorithms::condensation(Graph::fromEdges(numVertices, edges));
+    CHECK(path.getNumVertices() == numVertices);
+    CHECK(path.getNumEdges() == numVertices - 1);
+    CHECK(path.getEdgeWeight(numVertices - 1, numVertices - 2) == 3);
+    CHECK(path.getEdgeWeight(numVertices - 2, numVertices - 1) == 0);
+}
+
+// Test Case for DisjointSet
+TEST_CASE("DisjointSet: Sequential and concurrent unions") 
+{
+    DisjointSet sets(6);
+    CHECK(sets.unite(0, 1) == true);
+    CHECK(sets.unite(2, 3) == true);
+    CHECK(sets.unite(1, 0) == false);
+    CHECK(sets.unite(3, 1) == true);
+    CHECK(sets.find(0) == sets.find(2));
+    CHECK(sets.find(4) != sets.find(5));
+
+    DisjointSet concurrent(6);
+    CHECK(concurrent.uniteConcurrent(5, 4) == true);
+    CHECK(concurrent.uniteConcurrent(4, 3) == true);
+    CHECK(concurrent.uniteConcurrent(3, 5) == false);
+    CHECK(concurrent.findConcurrent(5) == 3);
+}
+
+// Test Case for connectedComponents
+TEST_CASE("connectedComponents: Labels and sizes") 
+{
+    vector<vector<int>> graph1 = {
+        {0, 1, 0, 0, 0},
+        {1, 0, 0, 0, 0},
+        {0, 0, 0, 0, 3},
+        {0, 0, 0, 0, 0},
+        {0, 0, 3, 0, 0}};
+    g1.loadGraph(graph1);
+    ConnectedComponents components = Algorithms::connectedComponents(g1);
+    CHECK(components.label == vector<size_t>({0, 0, 1, 2, 1}));
+    CHECK(components.size == vector<size_t>({2, 2, 1}));
+
+    // Directed edges are followed in both directions (weakly connected components)
+    vector<vector<int>> graph2 = {
+        {0, 0, 0},
+        {1, 0, 0},
+        {0, 1, 0}};
+    g2.loadGraph(graph2);
+    CHECK(Algorithms::connectedComponents(g2).size == vector<size_t>({3}));
+    CHECK(Algorithms::isConnected(g2) == false);
+}
+
+TEST_CASE("connectedComponents: Parallel unions on a large graph") 
+{
+    // 8 disjoint paths interleaved over the vertices (vertex i is on path i % 8)
+    const size_t numVertices = 200000;
+    vector<Edge> edges;
+    for (size_t i = 0; i + 8 < numVertices; i++)
+    {
+        edges.push_back(Edge{i + 8, i, 1});
+    }
+    Graph paths = Graph::fromEdges(numVertices, edges);
+
+    Parallel::setNumThreads(4);
+    ConnectedComponents components = Algorithms::connectedComponents(paths);
+    Parallel::setNumThreads(0);
+
+    CHECK(components.size == vector<size_t>(8, numVertices / 8));
+    bool labelsMatch = true;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        labelsMatch = labelsMatch && components.label[i] == i % 8;
+    }
+    CHECK(labelsMatch);
+}
+
+// Test Case for getInEdges
+TEST_CASE("getInEdges: Reversed CSR index") 
+{
+    vector<vector<int>> graph1 = {
+        {0, 2, 3},
+        {0, 0, 4},
+        {5, 0, 0}};
+    g1.loadGraph(graph1);
+    const AdjacencyIndex& inEdges = g1.getInEdges();
+    CHECK(inEdges.numEntries() == 4);
+    CHECK(inEdges.degree(2) == 2);
+    CHECK(inEdges.findWeight(2, 0) == 3);
+    CHECK(inEdges.findWeight(2, 1) == 4);
+    CHECK(inEdges.findWeight(0, 2) == 5);
+    CHECK(inEdges.findWeight(1, 2) == 0);
+
+    // An undirected graph shares its out-edge index
+    vector<vector<int>> graph2 = {
+        {0, 1},
+        {1, 0}};
+    g2.loadGraph(graph2);
+    CHECK(&g2.getInEdges() == &g2.getOutEdges());
+}
+
+// Test Case for the direction-optimizing BFS
+TEST_CASE("shortestPath: BFS on a large grid does not depend on the number of threads") 
+{
+    // An unweighted 300x300 grid, with one-way edges to the right and down
+    const size_t side = 300;
+    vector<Edge> edges;
+    for (size_t row = 0; row < side; row++)
+    {
+        for (size_t col = 0; col < side; col++)
+        {
+            size_t vertex = row * side + col;
+            if (col + 1 < side)
+            {
+                edges.push_back(Edge{vertex, vertex + 1, 1});
+            }
+            if (row + 1 < side)
+            {
+                edges.push_back(Edge{vertex, vertex + side, 1});
+            }
+        }
+    }
+    Graph grid = Graph::fromEdges(side * side, edges);
+
+    string serial = Algorithms::shortestPath(grid, 0, side * side - 1);
+    Parallel::setNumThreads(4);
+    string parallel = Algorithms::shortestPath(grid, 0, side * side - 1);
+    bool connected = Algorithms::isConnected(grid);
+    Parallel::setNumThreads(0);
+
+    CHECK(serial == parallel);
+    CHECK(count(serial.begin(), serial.end(), '>') == 2 * (side - 1));
+    CHECK(serial.substr(0, 9) == "0->1->2->");
+    CHECK(connected == true);
+    CHECK(Algorithms::shortestPath(grid, side * side - 1, 0) == "No path exists between " + to_string(side * side - 1) + " and 0");
+}
+
+// Test Case for the multi-source BFS
+TEST_CASE("hopDistances and reachability: Batched BFS from several sources") 
+{
+    vector<vector<int>> graph1 = {
+        {0, 5, 0, 0},
+        {0, 0, 2, 0},
+        {0, 0, 0, 0},
+        {0, 0, 7, 0}};
+    g1.loadGraph(graph1);
+
+    vector<vector<size_t>> distance = Algorithms::hopDistances(g1, {0, 3, 2});
+    CHECK(distance[0] == vector<size_t>({0, 1, 2, SIZE_MAX}));
+    CHECK(distance[1] == vector<size_t>({SIZE_MAX, SIZE_MAX, 1, 0}));
+    CHECK(distance[2] == vector<size_t>({SIZE_MAX, SIZE_MAX, 0, SIZE_MAX}));
+
+    vector<vector<bool>> reachable = Algorithms::reachability(g1, {1});
+    CHECK(reachable[0] == vector<bool>({false, true, true, false}));
+
+    CHECK_THROWS(Algorithms::hopDistances(g1, {4}));
+}
+
+TEST_CASE("hopDistances: More sources than one batch") 
+{
+    // An undirected cycle: the hop distance between i and j is the shorter way around
+    const size_t numVertices = 150;
+    vector<Edge> edges;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        edges.push_back(Edge{i, (i + 1) % numVertices, 1});
+        edges.push_back(Edge{(i + 1) % numVertices, i, 1});
+    }
+    Graph cycle = Graph::fromEdges(numVertices, edges);
+
+    vector<size_t> sources;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        sources.push_back(i);
+    }
+    Parallel::setNumThreads(3);
+    vector<vector<size_t>> distance = Algorithms::hopDistances(cycle, sources);
+    Parallel::setNumThreads(0);
+
+    bool distancesMatch = true;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        for (size_t j = 0; j < numVertices; j++)
+        {
+            size_t gap = i > j ? i - j : j - i;
+            distancesMatch = distancesMatch && distance[i][j] == min(gap, numVertices - gap);
+        }
+    }
+    CHECK(distancesMatch);
+}
+
+// Test Case for the heap-based Dijkstra
+TEST_CASE("shortestPath: Dijkstra on a large sparse graph") 
+{
+    // A long chain with weight 2 per step, plus shortcuts i->i+2 with weight 3 from every even vertex
+    const size_t numVertices = 200001;
+    vector<Edge> edges;
+    for (size_t i = 0; i + 1 < numVertices; i++)
+    {
+        edges.push_back(Edge{i, i + 1, 2});
+        if (i % 2 == 0 && i + 2 < numVertices)
+        {
+            edges.push_back(Edge{i, i + 2, 3});
+        }
+    }
+    Graph chain = Graph::fromEdges(numVertices, edges);
+
+    CHECK(Algorithms::shortestPath(chain, 0, 6) == "0->2->4->6");
+    CHECK(Algorithms::shortestPath(chain, 3, 7) == "3->4->6->7");
+    CHECK(Algorithms::shortestPath(chain, 5, 1) == "No path exists between 5 and 1");
+
+    string path = Algorithms::shortestPath(chain, 0, 20000);
+    CHECK(count(path.begin(), path.end(), '>') == 10000);
+}
+
+// Test Case for the dense Dijkstra
+TEST_CASE("shortestPath: Dijkstra on a complete graph") 
+{
+    // Every edge costs 100, except for a chain i->i+1 that costs 1 per step
+    const size_t numVertices = 203;
+    vector<vector<int>> matrix(numVertices, vector<int>(numVertices, 100));
+    vector<Edge> edges;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        matrix[i][i] = 0;
+        if (i + 1 < numVertices)
+        {
+            matrix[i][i + 1] = 1;
+        }
+        for (size_t j = 0; j < numVertices; j++)
+        {
+            edges.push_back(Edge{i, j, matrix[i][j]});
+        }
+    }
+    g1.loadGraph(matrix);
+    Graph sparse = Graph::fromEdges(numVertices, edges);
+
+    // Up to 99 steps along the chain are cheaper than one direct edge
+    string expected = "0";
+    for (size_t i = 1; i <= 99; i++)
+    {
+        expected += "->" + to_string(i);
+    }
+    CHECK(Algorithms::shortestPath(g1, 0, 99) == expected);
+    CHECK(Algorithms::shortestPath(sparse, 0, 99) == expected);
+    CHECK(Algorithms::shortestPath(g1, 0, 150) == "0->150");
+    CHECK(Algorithms::shortestPath(g1, 202, 5) == "202->5");
+
+    // A sparsely stored copy relaxes its rows through a scratch row and takes the same route
+    CHECK(Algorithms::shortestPath(sparse, 150, 152) == "150->151->152");
+}
+
+// Test Case for getMinWeight and getMaxWeight
+TEST_CASE("getMinWeight and getMaxWeight: Cached weight range") 
+{
+    vector<vector<int>> graph1 = {
+        {0, 4, 0},
+        {4, 0, -2},
+        {0, -2, 0}};
+    g1.loadGraph(graph1);
+    CHECK(g1.getMinWeight() == -2);
+    CHECK(g1.getMaxWeight() == 4);
+
+    // Modifying the graph drops the cached range
+    g1 *= 3;
+    CHECK(g1.getMinWeight() == -6);
+    CHECK(g1.getMaxWeight() == 12);
+
+    vector<vector<int>> graph2 = {
+        {0, 0},
+        {0, 0}};
+    g2.loadGraph(graph2);
+    CHECK(g2.getMinWeight() == 0);
+    CHECK(g2.getMaxWeight() == 0);
+}
+
+// Test Case for the integer priority queues
+TEST_CASE("shortestPath: Bucket queue, radix heap and bidirectional Dijkstra agree") 
+{
+    // A sparse pseudo-random graph with weights 1..10 (many ties), scaled so that each priority queue is picked in turn
+    const size_t numVertices = 2000;
+    vector<Edge> edges;
+    unsigned seed = 7;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            size_t target = (seed >> 8) % numVertices;
+            seed = seed * 1103515245u + 12345u;
+            edges.push_back(Edge{i, target, static_cast<int>(1 + (seed >> 8) % 10)});
+        }
+    }
+    vector<Edge> radixEdges = edges;
+    vector<Edge> heapEdges = edges;
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        radixEdges[i].weight *= 1000;
+        heapEdges[i].weight *= 100000;
+    }
+    Graph dial = Graph::fromEdges(numVertices, edges);
+    Graph radix = Graph::fromEdges(numVertices, radixEdges);
+    Graph heap = Graph::fromEdges(numVertices, heapEdges);
+
+    bool pathsMatch = true;
+    for (size_t end = 1; end < numVertices; end += 37)
+    {
+        string path = Algorithms::shortestPath(dial, 0, end);
+        pathsMatch = pathsMatch && path == Algorithms::shortestPath(radix, 0, end) && path == Algorithms::shortestPath(heap, 0, end);
+    }
+    CHECK(pathsMatch);
+}
+
+// Test Case for the bidirectional BFS
+TEST_CASE("shortestPath: Bidirectional BFS returns the same path as a forward search") 
+{
+    // A sparse pseudo-random unweighted graph; doubling the weights keeps the same paths but forces a forward Dijkstra
+    const size_t numVertices = 3000;
+    vector<Edge> edges;
+    unsigned seed = 11;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        for (size_t k = 0; k < 2; k++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            edges.push_back(Edge{i, (seed >> 8) % numVertices, 1});
+        }
+    }
+    vector<Edge> doubledEdges = edges;
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        doubledEdges[i].weight = 2;
+    }
+    Graph unweighted = Graph::fromEdges(numVertices, edges);
+    Graph doubled = Graph::fromEdges(numVertices, doubledEdges);
+
+    bool pathsMatch = true;
+    for (size_t end = 1; end < numVertices; end += 29)
+    {
+        pathsMatch = pathsMatch && Algorithms::shortestPath(unweighted, 0, end) == Algorithms::shortestPath(doubled, 0, end);
+        pathsMatch = pathsMatch && Algorithms::shortestPath(unweighted, end, 0) == Algorithms::shortestPath(doubled, end, 0);
+    }
+    CHECK(pathsMatch);
+}
+
+// Test Case for the ALT landmark index
+TEST_CASE("shortestPath: A* with landmarks returns the same paths") 
+{
+    // A sparse pseudo-random graph with weights 1..20; a copy without landmarks answers with a bucket queue
+    const size_t numVertices = 2500;
+    vector<Edge> edges;
+    unsigned seed = 3;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            size_t target = (seed >> 8) % numVertices;
+            seed = seed * 1103515245u + 12345u;
+            edges.push_back(Edge{i, target, static_cast<int>(1 + (seed >> 8) % 20)});
+        }
+    }
+    Graph withLandmarks = Graph::fromEdges(numVertices, edges);
+    Graph withoutLandmarks = Graph::fromEdges(numVertices, edges);
+
+    CHECK(withLandmarks.hasLandmarks() == false);
+    const LandmarkIndex& landmarks = withLandmarks.getLandmarks();
+    CHECK(withLandmarks.hasLandmarks() == true);
+    CHECK(landmarks.getLandmarks().size() == LandmarkIndex::DEFAULT_NUM_LANDMARKS);
+    CHECK(landmarks.lowerBound(5, 5) == 0);
+
+    bool pathsMatch = true;
+    for (size_t end = 1; end < numVertices; end += 31)
+    {
+        pathsMatch = pathsMatch && Algorithms::shortestPath(withLandmarks, end / 2, end) == Algorithms::shortestPath(withoutLandmarks, end / 2, end);
+    }
+    CHECK(pathsMatch);
+
+    // A query never builds the index by itself, however large the graph is
+    vector<Edge> chain;
+    for (size_t i = 0; i + 1 < 5000; i++)
+    {
+        chain.push_back(Edge{i, i + 1, 2});
+    }
+    Graph large = Graph::fromEdges(5000, chain);
+    PathResult result;
+    Algorithms::shortestPath(large, 0, 4999, result);
+    CHECK(result.distance == 9998);
+    CHECK(large.hasLandmarks() == false);
+
+    // The index is rebuilt after the graph changes, and refused for negative weights
+    withLandmarks *= -1;
+    CHECK(withLandmarks.hasLandmarks() == false);
+    CHECK_THROWS(withLandmarks.getLandmarks());
+}
+
+// Test Case for concurrent queries
+TEST_CASE("Graph: Lazily built indexes are shared by concurrent queries") 
+{
+    // A directed weighted ring with chords, whose indexes are all built by the first queries of the threads
+    const size_t numVertices = 300;
+    vector<Edge> edges;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        edges.push_back(Edge{i, (i + 1) % numVertices, 3});
+        edges.push_back(Edge{i, (i * 7 + 5) % numVertices, static_cast<int>(1 + i % 9)});
+    }
+    Graph shared = Graph::fromEdges(numVertices, edges);
+    Graph reference = Graph::fromEdges(numVertices, edges);
+
+    vector<string> paths(8);
+    vector<const AdjacencyIndex*> inEdges(8);
+    vector<thread> workers;
+    for (size_t worker = 0; worker < 8; worker++)
+    {
+        workers.push_back(thread([&shared, &paths, &inEdges, worker]()
+        {
+            inEdges[worker] = &shared.getInEdges();
+            shared.getLandmarks();
+            paths[worker] = Algorithms::shortestPath(shared, worker, numVertices - 1 - worker);
+        }));
+    }
+    for (size_t worker = 0; worker < 8; worker++)
+    {
+        workers[worker].join();
+    }
+
+    bool consistent = true;
+    for (size_t worker = 0; worker < 8; worker++)
+    {
+        consistent = consistent && inEdges[worker] == inEdges[0];
+        consistent = consistent && paths[worker] == Algorithms::shortestPath(reference, worker, numVertices - 1 - worker);
+    }
+    CHECK(consistent);
+    CHECK(shared.hasLandmarks() == true);
+}
+
+// Test Case for contraction hierarchies
+TEST_CASE("shortestPath: contraction hierarchies return the same paths") 
+{
+    // A sparse pseudo-random graph with weights 1..10 (many equal-length paths), and an unweighted grid (even more)
+    const size_t numVertices = 800;
+    vector<Edge> edges;
+    unsigned seed = 11;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        for (size_t k = 0; k < 3; k++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            size_t target = (seed >> 8) % numVertices;
+            seed = seed * 1103515245u + 12345u;
+            edges.push_back(Edge{i, target, static_cast<int>(1 + (seed >> 8) % 10)});
+        }
+    }
+    vector<Edge> gridEdges;
+    for (size_t row = 0; row < 20; row++)
+    {
+        for (size_t col = 0; col < 20; col++)
+        {
+            size_t vertex = row * 20 + col;
+            if (col + 1 < 20)
+            {
+                gridEdges.push_back(Edge{vertex, vertex + 1, 1});
+                gridEdges.push_back(Edge{vertex + 1, vertex, 1});
+            }
+            if (row + 1 < 20)
+            {
+                gridEdges.push_back(Edge{vertex, vertex + 20, 1});
+                gridEdges.push_back(Edge{vertex + 20, vertex, 1});
+            }
+        }
+    }
+
+    Graph withHierarchy = Graph::fromEdges(numVertices, edges);
+    Graph withoutHierarchy = Graph::fromEdges(numVertices, edges);
+    Graph grid = Graph::fromEdges(400, gridEdges);
+    Graph plainGrid = Graph::fromEdges(400, gridEdges);
+    CHECK(withHierarchy.hasContractionHierarchy() == false);
+    const ContractionHierarchy& hierarchy = withHierarchy.getContractionHierarchy();
+    grid.getContractionHierarchy();
+    CHECK(withHierarchy.hasContractionHierarchy() == true);
+    CHECK(hierarchy.getNumVertices() == numVertices);
+    CHECK(hierarchy.distance(7, 7) == 0);
+    CHECK(grid.getContractionHierarchy().distance(0, 399) == 38);
+
+    bool pathsMatch = true;
+    for (size_t end = 1; end < numVertices; end += 19)
+    {
+        pathsMatch = pathsMatch && Algorithms::shortestPath(withHierarchy, end / 3, end) == Algorithms::shortestPath(withoutHierarchy, end / 3, end);
+    }
+    for (size_t end = 1; end < 400; end += 13)
+    {
+        pathsMatch = pathsMatch && Algorithms::shortestPath(grid, 399 - end, end) == Algorithms::shortestPath(plainGrid, 399 - end, end);
+    }
+    CHECK(pathsMatch);
+
+    // A saved hierarchy can be attached to the same graph only
+    hierarchy.save("test_graph.ch");
+    Graph reopened = Graph::fromEdges(numVertices, edges);
+    reopened.setContractionHierarchy(ContractionHierarchy::load("test_graph.ch"));
+    CHECK(reopened.hasContractionHierarchy() == true);
+    CHECK(Algorithms::shortestPath(reopened, 3, 700) == Algorithms::shortestPath(withoutHierarchy, 3, 700));
+    CHECK_THROWS(grid.setContractionHierarchy(ContractionHierarchy::load("test_graph.ch")));
+    remove("test_graph.ch");
+    CHECK_THROWS(ContractionHierarchy::load("test_graph.ch"));
+
+    // The hierarchy is dropped when the graph changes, and refused for negative weights
+    withHierarchy *= -1;
+    CHECK(withHierarchy.hasContractionHierarchy() == false);
+    CHECK_THROWS(withHierarchy.getContractionHierarchy());
+}
+
+// Test Case for the worklist Bellman-Ford
+TEST_CASE("shortestPath: Bellman-Ford stops once the distances settle") 
+{
+    // A long chain with negative weights (and a costly shortcut) settles in a couple of passes
+    const size_t numVertices = 10000;
+    vector<Edge> edges;
+    for (size_t i = 0; i + 1 < numVertices; i++)
+    {
+        edges.push_back(Edge{i, i + 1, i % 2 == 0 ? -1 : 2});
+    }
+    edges.push_back(Edge{0, numVertices - 1, 20000});
+    Graph chain = Graph::fromEdges(numVertices, edges);
+    CHECK(Algorithms::shortestPath(chain, 0, 4) == "0->1->2->3->4");
+    CHECK(Algorithms::shortestPath(chain, 3, 1) == "No path exists between 3 and 1");
+    string path = Algorithms::shortestPath(chain, 0, 2000);
+    CHECK(count(path.begin(), path.end(), '>') == 2000);
+
+    // Closing the chain into a negative cycle is found long before V passes
+    edges.push_back(Edge{numVertices - 1, 0, -20000});
+    Graph cycle = Graph::fromEdges(numVertices, edges);
+    CHECK(Algorithms::shortestPath(cycle, 0, 10) == "Graph contains a negative cycle");
+
+    // A negative self-loop is a negative cycle as well
+    vector<vector<int>> graph1 = {
+        {0, 2, 0},
+        {0, -1, 3},
+        {0, 0, 0}};
+    g1.loadGraph(graph1);
+    CHECK(Algorithms::shortestPath(g1, 0, 2) == "Graph contains a negative cycle");
+}
+
+TEST_CASE("negativeCycle: subtree disassembly reports the first cycle it closes") 
+{
+    // A long chain with negative weights has no cycle and is checked in one sweep
+    const size_t numVertices = 200000;
+    vector<Edge> edges;
+    for (size_t i = 0; i + 1 < numVertices; i++)
+    {
+        edges.push_back(Edge{i, i + 1, i % 2 == 0 ? -3 : 1});
+    }
+    Graph chain = Graph::fromEdges(numVertices, edges);
+    CHECK(Algorithms::negativeCycle(chain) == "No negative cycle exists");
+
+    // A small cycle at the start is reported without going through the rest of the graph
+    edges.push_back(Edge{2, 0, 1});
+    Graph cycle = Graph::fromEdges(numVertices, edges);
+    CHECK(Algorithms::negativeCycle(cycle) == "0->1->2->0");
+
+    // Undirected negative edges around a cycle that does not go through vertex 0
+    vector<vector<int>> graph1 = {
+        {0, 1, -6, 0},
+        {1, 0, -7, 5},
+        {-6, -7, 0, -1},
+        {0, 5, -1, 0}};
+    g1.loadGraph(graph1);
+    CHECK(Algorithms::negativeCycle(g1) == "1->2->3->1");
+}
+
+TEST_CASE("Parallel: the shared threads run nested work and pass on exceptions") 
+{
+    Parallel::setNumThreads(4);
+    atomic<size_t> total(0);
+    Parallel::run(4, [&total](size_t outer)
+    {
+        Parallel::run(4, [&total, outer](size_t inner)
+        {
+            total += outer * 4 + inner;
+        });
+    });
+    CHECK(total.load() == 120);
+
+    CHECK_THROWS_AS(Parallel::run(3, [](size_t worker)
+    {
+        if (worker == 2)
+        {
+            throw runtime_error("worker failed");
+        }
+    }), runtime_error);
+    Parallel::setNumThreads(0);
+}
+
+TEST_CASE("shortestPath: delta-stepping and parallel Bellman-Ford on large graphs") 
+{
+    // A 256x256 grid with weights 1..100: delta-stepping (several threads) returns the paths of A* with landmarks
+    const size_t side = 256;
+    const size_t numVertices = side * side;
+    vector<Edge> edges;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        if (i % side + 1 < side)
+        {
+            edges.push_back(Edge{i, i + 1, static_cast<int>(1 + i * 7 % 100)});
+            edges.push_back(Edge{i + 1, i, static_cast<int>(1 + i * 13 % 100)});
+        }
+        if (i + side < numVertices)
+        {
+            edges.push_back(Edge{i, i + side, static_cast<int>(1 + i * 29 % 100)});
+            edges.push_back(Edge{i + side, i, static_cast<int>(1 + i * 31 % 100)});
+        }
+    }
+    Graph grid = Graph::fromEdges(numVertices, edges);
+    const size_t queries[][2] = {{0, numVertices - 1}, {side - 1, numVertices - side}, {12345, 54321}, {40000, 39999}};
+    vector<string> parallelPaths;
+    Parallel::setNumThreads(4);
+    for (size_t i = 0; i < 4; i++)
+    {
+        parallelPaths.push_back(Algorithms::shortestPath(grid, queries[i][0], queries[i][1]));
+    }
+    Parallel::setNumThreads(1);
+    for (size_t i = 0; i < 4; i++)
+    {
+        CHECK(Algorithms::shortestPath(grid, queries[i][0], queries[i][1]) == parallelPaths[i]);
+    }
+    Parallel::setNumThreads(0);
+
+    // Negative weights: jumps of 3 vertices (weight -4) beat steps of one vertex (weight -1) on the first 1000 vertices
+    edges.clear();
+    for (size_t i = 0; i + 1 < 1000; i++)
+    {
+        edges.push_back(Edge{i, i + 1, -1});
+        if (i + 3 < 1000)
+        {
+            edges.push_back(Edge{i, i + 3, -4});
+        }
+    }
+    Graph jumps = Graph::fromEdges(numVertices, edges);
+    Parallel::setNumThreads(4);
+    CHECK(Algorithms::shortestPath(jumps, 0, 6) == "0->3->6");
+    CHECK(Algorithms::shortestPath(jumps, 1, 7) == "1->4->7");
+    CHECK(Algorithms::shortestPath(jumps, 8, 1) == "No path exists between 8 and 1");
+
+    // Closing the chain into a negative cycle is found by the parent check, long before V rounds
+    edges.push_back(Edge{999, 0, 1000});
+    Graph cycle = Graph::fromEdges(numVertices, edges);
+    CHECK(Algorithms::shortestPath(cycle, 0, 6) == "Graph contains a negative cycle");
+
+    // An undirected negative edge is not a cycle, as in the sequential search
+    edges.pop_back();
+    edges.push_back(Edge{1, 0, -1});
+    Graph undirected = Graph::fromEdges(numVertices, edges);
+    CHECK(Algorithms::shortestPath(undirected, 0, 6) == "0->3->6");
+    Parallel::setNumThreads(0);
+}
+
+TEST_CASE("allPairsShortestPaths: distances and next hops") 
+{
+    vector<vector<int>> graph1 = {
+        {0, 4, 0, 5},
+        {0, 0, -3, 0},
+        {2, 0, 0, 0},
+        {0, 0, -1, 0}};
+    g1.loadGraph(graph1);
+    AllPairsShortestPaths paths = Algorithms::allPairsShortestPaths(g1);
+    CHECK(paths.hasNegativeCycle == false);
+    CHECK(paths.distance[0] == vector<long long>({0, 4, 1, 5}));
+    CHECK(paths.distance[3] == vector<long long>({1, 5, -1, 0}));
+    CHECK(paths.next[0] == vector<size_t>({0, 1, 1, 3}));
+    CHECK(paths.next[1][3] == 2);
+    CHECK(paths.next[2][3] == 0);
+
+    // Unreachable vertices
+    vector<vector<int>> graph2 = {
+        {0, 1, 0},
+        {0, 0, 0},
+        {0, 1, 0}};
+    g2.loadGraph(graph2);
+    paths = Algorithms::allPairsShortestPaths(g2);
+    CHECK(paths.distance[1][0] == LLONG_MAX);
+    CHECK(paths.next[1][0] == SIZE_MAX);
+    CHECK(paths.distance[2][1] == 1);
+
+    // Negative cycles, including an undirected edge with a negative weight
+    vector<vector<int>> graph3 = {
+        {0, 1, 0},
+        {0, 0, -3},
+        {1, 0, 0}};
+    g3.loadGraph(graph3);
+    CHECK(Algorithms::allPairsShortestPaths(g3).hasNegativeCycle == true);
+    CHECK(Algorithms::allPairsShortestPaths(g3).distance.empty());
+    vector<vector<int>> graph4 = {
+        {0, -1},
+        {-1, 0}};
+    Graph undirected;
+    undirected.loadGraph(graph4);
+    CHECK(Algorithms::allPairsShortestPaths(undirected).hasNegativeCycle == true);
+
+    // Weights too large for int distances
+    vector<Edge> edges = {Edge{0, 1, 2000000000}, Edge{1, 2, 2000000000}, Edge{2, 3, -1000000000}};
+    Graph heavy = Graph::fromEdges(4, edges);
+    CHECK(Algorithms::allPairsShortestPaths(heavy).distance[0][3] == 3000000000LL);
+}
+
+TEST_CASE("allPairsShortestPaths: blocked rounds on several threads match single-source searches") 
+{
+    // 150 vertices (three blocks, the last one padded) with random weights, dense enough for Floyd-Warshall
+    const size_t numVertices = 150;
+    vector<Edge> edges;
+    unsigned seed = 7;
+    for (size_t i = 0; i < 12 * numVertices; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        size_t source = (seed >> 8) % numVertices;
+        seed = seed * 1103515245u + 12345u;
+        size_t target = (seed >> 8) % numVertices;
+        edges.push_back(Edge{source, target, static_cast<int>(1 + (seed >> 16) % 50)});
+    }
+    Graph random = Graph::fromEdges(numVertices, edges);
+
+    Parallel::setNumThreads(3);
+    AllPairsShortestPaths paths = Algorithms::allPairsShortestPaths(random);
+    Parallel::setNumThreads(0);
+
+    bool distancesMatch = true;
+    bool hopsMatch = true;
+    for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u += 7)
+    {
+        for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v++)
+        {
+            if (vertex_v == vertex_u)
+            {
+                continue;
+            }
+            string path = Algorithms::shortestPath(random, vertex_u, vertex_v);
+            if (path.compare(0, 8, "No path ") == 0)
+            {
+                distancesMatch = distancesMatch && paths.distance[vertex_u][vertex_v] == LLONG_MAX;
+                continue;
+            }
+
+            // The length of the path found by shortestPath
+            long long length = 0;
+            istringstream stream(path);
+            size_t from = 0;
+            size_t to = 0;
+            stream >> from;
+            while (stream.ignore(2) >> to)
+            {
+                length += random.getEdgeWeight(from, to);
+                from = to;
+            }
+            distancesMatch = distancesMatch && paths.distance[vertex_u][vertex_v] == length;
+
+            // Following the next hops gives a path of the same length
+            long long walked = 0;
+            for (size_t current = vertex_u; current != vertex_v; current = paths.next[current][vertex_v])
+            {
+                walked += random.getEdgeWeight(current, paths.next[current][vertex_v]);
+            }
+            hopsMatch = hopsMatch && walked == length;
+        }
+    }
+    CHECK(distancesMatch);
+    CHECK(hopsMatch);
+}
+
+TEST_CASE("allPairsShortestPaths: Johnson's algorithm on sparse graphs with negative weights") 
+{
+    // A ring of 400 vertices with negative steps and a few positive chords
+    const size_t numVertices = 400;
+    vector<Edge> edges;
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        edges.push_back(Edge{i, (i + 1) % numVertices, i % 3 == 0 ? -2 : 3});
+        if (i % 10 == 0)
+        {
+            edges.push_back(Edge{i, (i + 37) % numVertices, 5});
+        }
+    }
+    Graph ring = Graph::fromEdges(numVertices, edges);
+
+    Parallel::setNumThreads(4);
+    AllPairsShortestPaths paths = Algorithms::allPairsShortestPaths(ring);
+    Parallel::setNumThreads(0);
+    REQUIRE(paths.hasNegativeCycle == false);
+
+    // The distances match Bellman-Ford's paths, and the next hops walk along paths of the same length
+    bool distancesMatch = true;
+    bool hopsMatch = true;
+    for (size_t vertex_u = 0; vertex_u < numVertices; vertex_u += 41)
+    {
+        for (size_t vertex_v = 0; vertex_v < numVertices; vertex_v += 3)
+        {
+            if (vertex_v == vertex_u)
+            {
+                continue;
+            }
+            long long length = 0;
+            istringstream stream(Algorithms::shortestPath(ring, vertex_u, vertex_v));
+            size_t from = 0;
+            size_t to = 0;
+            stream >> from;
+            while (stream.ignore(2) >> to)
+            {
+                length += ring.getEdgeWeight(from, to);
+                from = to;
+            }
+            distancesMatch = distancesMatch && paths.distance[vertex_u][vertex_v] == length;
+
+            long long walked = 0;
+            for (size_t current = vertex_u; current != vertex_v; current = paths.next[current][vertex_v])
+            {
+                walked += ring.getEdgeWeight(current, paths.next[current][vertex_v]);
+            }
+            hopsMatch = hopsMatch && walked == length;
+        }
+    }
+    CHECK(distancesMatch);
+    CHECK(hopsMatch);
+    CHECK(paths.distance[0][3] == 4);
+    CHECK(paths.next[0][37] == 37);
+
+    // A negative cycle through the chords, and an undirected edge with a negative weight
+    edges.push_back(Edge{37, 0, -100});
+    CHECK(Algorithms::allPairsShortestPaths(Graph::fromEdges(numVertices, edges)).hasNegativeCycle == true);
+    edges.pop_back();
+    edges.push_back(Edge{1, 0, -2});
+    CHECK(Algorithms::allPairsShortestPaths(Graph::fromEdges(numVertices, edges)).hasNegativeCycle == true);
+}
+
+TEST_CASE("allPairsHopDistances: Seidel's algorithm on dense undirected graphs") 
+{
+    // A clique of 200 vertices with a tail of 100 vertices, and an isolated vertex
+    const size_t numVertices = 301;
+    vector<Edge> edges;
+    for (size_t i = 0; i < 200; i++)
+    {
+        for (size_t j = 0; j < 200; j++)
+        {
+            if (i != j)
+            {
+                edges.push_back(Edge{i, j, 1});
+            }
+        }
+    }
+    for (size_t i = 199; i < 299; i++)
+    {
+        edges.push_back(Edge{i, i + 1, 1});
+        edges.push_back(Edge{i + 1, i, 1});
+    }
+    Graph lollipop = Graph::fromEdges(numVertices, edges);
+    vector<size_t> sources(numVertices);
+    for (size_t vertex = 0; vertex < numVertices; vertex++)
+    {
+        sources[vertex] = vertex;
+    }
+
+    // The products are split between the threads, and the squares are unwound through 7 levels
+    Parallel::setNumThreads(3);
+    vector<vector<size_t>> distance = Algorithms::allPairsHopDistances(lollipop);
+    Parallel::setNumThreads(0);
+    CHECK(distance == Algorithms::hopDistances(lollipop, sources));
+    CHECK(distance[0][199] == 1);
+    CHECK(distance[0][299] == 101);
+    CHECK(distance[299][250] == 49);
+    CHECK(distance[5][5] == 0);
+    CHECK(distance[0][300] == SIZE_MAX);
+    CHECK(distance[300][300] == 0);
+
+    // A directed edge makes the graph directed, which falls back to a BFS from every vertex
+    edges.push_back(Edge{300, 0, 1});
+    Graph directed = Graph::fromEdges(numVertices, edges);
+    distance = Algorithms::allPairsHopDistances(directed);
+    CHECK(distance == Algorithms::hopDistances(directed, sources));
+    CHECK(distance[300][299] == 102);
+    CHECK(distance[0][300] == SIZE_MAX);
+}
+
+TEST_CASE("shortestPath: typed results and the string formatter") 
+{
+    Graph g;
+    vector<vector<int>> graph = {
+        {0, 4, 1, 0},
+        {4, 0, 2, 0},
+        {1, 2, 0, 0},
+        {0, 0, 0, 0}};
+    g.loadGraph(graph);
+
+    // One buffer serves every query, and each query resets it
+    PathResult result;
+    Algorithms::shortestPath(g, 0, 1, result);
+    CHECK(result.status == PathStatus::Found);
+    CHECK(result.distance == 3);
+    CHECK(result.path == vector<size_t>({0, 2, 1}));
+    CHECK(Algorithms::formatPath(result) == "0->2->1");
+
+    Algorithms::shortestPath(g, 0, 3, result);
+    CHECK(result.status == PathStatus::NoPath);
+    CHECK(result.path.empty());
+    CHECK(Algorithms::formatPath(result) == "No path exists between 0 and 3");
+    Algorithms::shortestPath(g, 2, 2, result);
+    CHECK(result.status == PathStatus::SameVertex);
+    CHECK(Algorithms::formatPath(result) == "No path exists between a vertex and itself");
+    Algorithms::shortestPath(g, 0, 4, result);
+    CHECK(result.status == PathStatus::InvalidVertex);
+    CHECK(Algorithms::formatPath(result) == "Invalid start or end vertex");
+
+    vector<vector<int>> cycle = {
+        {0, 1, 0},
+        {0, 0, -3},
+        {1, 0, 0}};
+    g.loadGraph(cycle);
+    Algorithms::shortestPath(g, 0, 2, result);
+    CHECK(result.status == PathStatus::NegativeCycle);
+    CHECK(Algorithms::formatPath(result) == "Graph contains a negative cycle");
+
+    // A long chain is returned as vertices, and formatted in one pass
+    const size_t numVertices = 50000;
+    vector<Edge> edges;
+    for (size_t i = 0; i + 1 < numVertices; i++)
+    {
+        edges.push_back(Edge{i, i + 1, 1});
+    }
+    Graph chain = Graph::fromEdges(numVertices, edges);
+    Algorithms::shortestPath(chain, 0, numVertices - 1, result);
+    REQUIRE(result.status == PathStatus::Found);
+    CHECK(result.distance == 49999);
+    CHECK(result.path.size() == numVertices);
+    CHECK(result.path[12345] == 12345);
+    string formatted = Algorithms::formatPath(result);
+    CHECK(formatted.substr(0, 8) == "0->1->2-");
+    CHECK(formatted.substr(formatted.size() - 7) == "->49999");
+
+    // The distance of a path through a contraction hierarchy is summed along the path
+    edges.clear();
+    for (size_t i = 0; i < 100; i++)
+    {
+        edges.push_back(Edge{i, (i + 1) % 100, 2});
+        edges.push_back(Edge{i, (i + 7) % 100, 9});
+    }
+    Graph ring = Graph::fromEdges(100, edges);
+    Graph plainRing = Graph::fromEdges(100, edges);
+    ring.getContractionHierarchy();
+    PathResult plain;
+    Algorithms::shortestPath(ring, 3, 40, result);
+    Algorithms::shortestPath(plainRing, 3, 40, plain);
+    CHECK(result.status == PathStatus::Found);
+    CHECK(result.distance == plain.distance);
+    CHECK(result.path == plain.path);
+    CHECK(result.distance == 5 * 9 + 2 * 2);
+}
+
+TEST_CASE("isContainsCycle, isBipartite and negativeCycle: typed results") 
+{
+    Graph g;
+    vector<vector<int>> directedCycle = {
+        {0, 1, 0, 0},
+        {0, 0, 1, 0},
+        {1, 0, 0, 1},
+        {0, 0, 0, 0}};
+    g.loadGraph(directedCycle);
+
+    // One buffer serves every query, and each query resets it
+    CycleResult cycle;
+    Algorithms::isContainsCycle(g, cycle);
+    CHECK(cycle.found == true);
+    CHECK(cycle.cycle == vector<size_t>({0, 1, 2, 0}));
+    CHECK(Algorithms::formatCycle(cycle) == "0->1->2->0");
+    CHECK(Algorithms::isContainsCycle(g) == "0->1->2->0");
+
+    vector<vector<int>> dag = {
+        {0, 1, 1},
+        {0, 0, 1},
+        {0, 0, 0}};
+    g.loadGraph(dag);
+    Algorithms::isContainsCycle(g, cycle);
+    CHECK(cycle.found == false);
+    CHECK(cycle.cycle.empty());
+    CHECK(Algorithms::isContainsCycle(g) == "0");
+
+    // The sides of a square, and a triangle that has none
+    vector<vector<int>> square = {
+        {0, 1, 0, 1},
+        {1, 0, 1, 0},
+        {0, 1, 0, 1},
+        {1, 0, 1, 0}};
+    g.loadGraph(square);
+    BipartiteResult sides;
+    Algorithms::isBipartite(g, sides);
+    CHECK(sides.isBipartite == true);
+    CHECK(sides.label == vector<int>({0, 1, 0, 1}));
+    CHECK(Algorithms::formatBipartition(sides) == "The graph is bipartite: A={0,2}, B={1,3}");
+
+    vector<vector<int>> triangle = {
+        {0, 1, 1},
+        {1, 0, 1},
+        {1, 1, 0}};
+    g.loadGraph(triangle);
+    Algorithms::isBipartite(g, sides);
+    CHECK(sides.isBipartite == false);
+    CHECK(sides.label.empty());
+    CHECK(Algorithms::formatBipartition(sides) == "The graph is not bipartite");
+
+    // A negative cycle closed by the subtree disassembly, a negative self-loop, and none
+    vector<vector<int>> negative = {
+        {0, 1, -6, 0},
+        {1, 0, -7, 5},
+        {-6, -7, 0, -1},
+        {0, 5, -1, 0}};
+    g.loadGraph(negative);
+    Algorithms::negativeCycle(g, cycle);
+    CHECK(cycle.found == true);
+    CHECK(cycle.cycle == vector<size_t>({1, 2, 3, 1}));
+    CHECK(Algorithms::negativeCycle(g) == "1->2->3->1");
+
+    vector<vector<int>> selfLoop = {
+        {0, 2},
+        {0, -1}};
+    g.loadGraph(selfLoop);
+    Algorithms::negativeCycle(g, cycle);
+    CHECK(cycle.found == true);
+    CHECK(cycle.cycle == vector<size_t>({1, 1}));
+
+    g.loadGraph(dag);
+    Algorithms::negativeCycle(g, cycle);
+    CHECK(cycle.found == false);
+    CHECK(cycle.cycle.empty());
+    CHECK(Algorithms::negativeCycle(g) == "No negative cycle exists");
+}
+
+TEST_CASE("singleSourceShortestPaths: one search for the paths to every vertex") 
+{
+    // A grid with many ties: every path read from the tree is the one shortestPath returns
+    const size_t side = 30;
+    vector<Edge> edges;
+    for (size_t row = 0; row < side; row++)
+    {
+        for (size_t col = 0; col < side; col++)
+        {
+            size_t vertex = row * side + col;
+            if (col + 1 < side)
+            {
+                edges.push_back(Edge{vertex, vertex + 1, static_cast<int>(1 + (row + col) % 2)});
+                edges.push_back(Edge{vertex + 1, vertex, 1});
+            }
+            if (row + 1 < side)
+            {
+                edges.push_back(Edge{vertex, vertex + side, static_cast<int>(1 + row % 3)});
+            }
+        }
+    }
+    Graph weighted = Graph::fromEdges(side * side, edges);
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        edges[i].weight = 1;
+    }
+    Graph unweighted = Graph::fromEdges(side * side, edges);
+
+    PathResult expected, result;
+    const Graph* graphs[] = {&weighted, &unweighted};
+    for (const Graph* graph : graphs)
+    {
+        ShortestPathTree tree = Algorithms::singleSourceShortestPaths(*graph, 7);
+        CHECK(tree.hasNegativeCycle == false);
+        CHECK(tree.parent[7] == SIZE_MAX);
+        for (size_t end = 0; end < side * side; end++)
+        {
+            Algorithms::shortestPath(*graph, 7, end, expected);
+            Algorithms::treePath(tree, end, result);
+            CHECK(result.status == expected.status);
+            CHECK(result.distance == expected.distance);
+            CHECK(result.path == expected.path);
+        }
+    }
+
+    // Negative weights go through Bellman-Ford, and an unreachable vertex has no distance
+    Graph g;
+    vector<vector<int>> negative = {
+        {0, 4, 2, 0},
+        {0, 0, 0, 0},
+        {0, -3, 0, 0},
+        {0, 1, 0, 0}};
+    g.loadGraph(negative);
+    ShortestPathTree tree = Algorithms::singleSourceShortestPaths(g, 0);
+    CHECK(tree.distance == vector<long long>({0, -1, 2, LLONG_MAX}));
+    CHECK(tree.parent == vector<size_t>({SIZE_MAX, 2, 0, SIZE_MAX}));
+    Algorithms::treePath(tree, 1, result);
+    CHECK(Algorithms::formatPath(result) == "0->2->1");
+    Algorithms::treePath(tree, 3, result);
+    CHECK(result.status == PathStatus::NoPath);
+    Algorithms::treePath(tree, 0, result);
+    CHECK(result.status == PathStatus::SameVertex);
+    Algorithms::treePath(tree, 4, result);
+    CHECK(result.status == PathStatus::InvalidVertex);
+
+    vector<vector<int>> cycle = {
+        {0, 1, 0},
+        {0, 0, -3},
+        {0, 1, 0}};
+    g.loadGraph(cycle);
+    tree = Algorithms::singleSourceShortestPaths(g, 0);
+    CHECK(tree.hasNegativeCycle == true);
+    Algorithms::treePath(tree, 2, result);
+    CHECK(result.status == PathStatus::NegativeCycle);
+    CHECK_THROWS(Algorithms::singleSourceShortestPaths(g, 3));
+}